@@ -0,0 +1,105 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "Adjacency.h"
+#include "Structures.h"
+
+struct ListHeader {
+    std::atomic<uint32_t> owners;  // graphs sharing the list
+    uint32_t capacity;             // cells following the header
+};
+
+static ListHeader *header_of(const uint32_t *list) {
+    return reinterpret_cast<ListHeader *>(const_cast<uint32_t *>(list)) - 1;
+}
+
+uint32_t *alloc_list(uint32_t capacity) {
+    if (capacity == 0) capacity = 1;
+    ListHeader *header = reinterpret_cast<ListHeader *>(
+        malloc(sizeof(ListHeader) + sizeof(uint32_t) * capacity));
+    new (&header->owners) std::atomic<uint32_t>(1);
+    header->capacity = capacity;
+    uint32_t *list = reinterpret_cast<uint32_t *>(header + 1);
+    list[0] = 0;
+    return list;
+}
+
+uint32_t *retain_list(uint32_t *list) {
+    header_of(list)->owners.fetch_add(1, std::memory_order_relaxed);
+    return list;
+}
+
+void release_list(uint32_t *list) {
+    if (list == nullptr) return;
+    ListHeader *header = header_of(list);
+    if (header->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        free(header);
+}
+
+uint32_t list_capacity(const uint32_t *list) {
+    return header_of(list)->capacity;
+}
+
+uint32_t *writable_list(uint32_t *&slot, uint32_t min_capacity) {
+    ListHeader *header = header_of(slot);
+    bool shared = header->owners.load(std::memory_order_acquire) > 1;
+    if (!shared && header->capacity >= min_capacity) return slot;
+
+    uint32_t capacity = header->capacity;
+    if (capacity < min_capacity) {
+        // grow geometrically so repeated additions stay amortised O(1)
+        capacity = std::max(min_capacity, capacity + capacity / 2);
+    }
+
+    if (!shared) {
+        header = reinterpret_cast<ListHeader *>(
+            realloc(header, sizeof(ListHeader) + sizeof(uint32_t) * capacity));
+        header->capacity = capacity;
+        slot = reinterpret_cast<uint32_t *>(header + 1);
+        return slot;
+    }
+
+    uint32_t *copy = alloc_list(capacity);
+    memcpy(copy, slot, sizeof(uint32_t) * (slot[0] + 1));
+    release_list(slot);
+    slot = copy;
+    return slot;
+}
+
+uint32_t *ListSharing::share(uint32_t *list) { return retain_list(list); }
+
+void ListSharing::release(uint32_t *list) { release_list(list); }
+
+void release_adjacency(AdjacencyMap *map) {
+    // the lists of the maps below are released with those maps
+    for (auto &entry : map->local) release_list(entry.second);
+    delete map;
+}
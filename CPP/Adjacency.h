@@ -0,0 +1,86 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef ADJACENCY_H_
+#define ADJACENCY_H_
+
+#include <cstdint>
+
+#include "Structures.h"
+
+// Adjacency lists keep their size in the first cell and the vertices after
+// it. Every list is preceded by a hidden header holding its capacity and the
+// number of graphs sharing it, so that forks of a graph can share lists and
+// only copy the ones they modify.
+
+/**
+ * @brief Allocates an empty adjacency list.
+ *
+ * @param capacity Number of cells of the list, including the size cell.
+ * @return uint32_t* The new list, with a size of 0 and a single owner.
+ */
+uint32_t *alloc_list(uint32_t capacity);
+
+/**
+ * @brief Registers one more owner of an adjacency list.
+ * @param list The list to share.
+ * @return uint32_t* The same list.
+ */
+uint32_t *retain_list(uint32_t *list);
+
+/**
+ * @brief Drops one owner of an adjacency list, freeing it after the last.
+ * @param list The list to release, may be nullptr.
+ */
+void release_list(uint32_t *list);
+
+/**
+ * @brief Returns the number of cells allocated for an adjacency list.
+ * @param list The list.
+ * @return uint32_t The capacity, including the size cell.
+ */
+uint32_t list_capacity(const uint32_t *list);
+
+/**
+ * @brief Makes the list stored in a slot safe to modify.
+ *
+ * If the list is shared with another graph it is copied first, and if it has
+ * fewer than `min_capacity` cells it is grown. The slot is updated to point
+ * to the resulting list.
+ *
+ * @param slot         The map entry holding the list.
+ * @param min_capacity Number of cells the list needs to hold.
+ * @return uint32_t* The list now stored in the slot.
+ */
+uint32_t *writable_list(uint32_t *&slot, uint32_t min_capacity = 0);
+
+/**
+ * @brief Releases every list set in an adjacency map and deletes the map.
+ *
+ * Used as the deleter of the maps shared between graph forks.
+ * @param map The map to release.
+ */
+void release_adjacency(AdjacencyMap *map);
+
+#endif  // ADJACENCY_H_
@@ -0,0 +1,196 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Anf.h"
+#include "Csr.h"
+#include "Data.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+// splitmix64 finalizer, spreads consecutive IDs over all 64 bits
+static inline uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// dst = max(dst, src) register by register; returns whether dst changed
+static inline bool merge(uint8_t *dst, const uint8_t *src, uint32_t m) {
+#if defined(__SSE2__)
+    __m128i changed = _mm_setzero_si128();
+    for (uint32_t r = 0; r < m; r += 16) {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + r));
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + r));
+        __m128i merged = _mm_max_epu8(d, s);
+        changed = _mm_or_si128(changed, _mm_xor_si128(merged, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + r), merged);
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(changed, _mm_setzero_si128())) !=
+           0xffff;
+#else
+    uint8_t changed = 0;
+    for (uint32_t r = 0; r < m; r++) {
+        uint8_t merged = std::max(dst[r], src[r]);
+        changed |= merged ^ dst[r];
+        dst[r] = merged;
+    }
+    return changed != 0;
+#endif
+}
+
+// HyperLogLog estimate with the linear counting correction for small sets
+static double estimate(const uint8_t *registers, uint32_t m,
+                       const double *inverse_powers) {
+    double sum = 0;
+    uint32_t zeros = 0;
+    for (uint32_t r = 0; r < m; r++) {
+        sum += inverse_powers[registers[r]];
+        zeros += registers[r] == 0;
+    }
+    double alpha = m == 16   ? 0.673
+                   : m == 32 ? 0.697
+                   : m == 64 ? 0.709
+                             : 0.7213 / (1 + 1.079 / m);
+    double e = alpha * m * m / sum;
+    if (e <= 2.5 * m && zeros) e = m * std::log(static_cast<double>(m) / zeros);
+    return e;
+}
+
+std::vector<double> hyper_anf(const CsrGraph &csr, uint32_t max_hops,
+                              uint32_t registers_log2,
+                              NeighborhoodFunction *function) {
+    uint32_t n = csr.n;
+    uint32_t b = std::min(16u, std::max(4u, registers_log2));
+    uint32_t m = 1u << b;
+    double inverse_powers[66];
+    for (int i = 0; i < 66; i++) inverse_powers[i] = std::ldexp(1.0, -i);
+
+    std::vector<uint8_t> current(static_cast<size_t>(n) * m, 0);
+    for (uint32_t v = 0; v < n; v++) {
+        if (!csr.present[v]) continue;
+        uint64_t h = mix(v);
+        uint32_t index = static_cast<uint32_t>(h >> (64 - b));
+        uint64_t rest = h << b;
+        uint8_t rho = rest ? __builtin_clzll(rest) + 1 : 64 - b + 1;
+        current[static_cast<size_t>(v) * m + index] = rho;
+    }
+    std::vector<uint8_t> next(current);
+    std::vector<uint8_t> changed(n, 1), changed_next(n, 0);
+    std::vector<double> size(n, 0);
+
+    std::mutex merge_sum;
+    auto total = [&]() {
+        double sum = 0;
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            double local = 0;
+            for (size_t v = from; v < to; v++) {
+                if (!csr.present[v]) continue;
+                size[v] = estimate(&current[v * m], m, inverse_powers);
+                local += size[v];
+            }
+            std::lock_guard<std::mutex> lock(merge_sum);
+            sum += local;
+        });
+        return sum;
+    };
+
+    NeighborhoodFunction summary;
+    summary.pairs.push_back(total());
+    for (uint32_t t = 0; t < max_hops; t++) {
+        std::atomic<bool> any(false);
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            bool local = false;
+            for (size_t v = from; v < to; v++) {
+                uint8_t *dst = &next[v * m];
+                bool dirty = false;
+                for (uint64_t e = csr.out_offsets[v];
+                     e < csr.out_offsets[v + 1]; e++) {
+                    uint32_t u = csr.out_targets[e];
+                    if (changed[u])
+                        dirty |= merge(dst, &current[size_t(u) * m], m);
+                }
+                changed_next[v] = dirty;
+                local |= dirty;
+            }
+            if (local) any = true;
+        });
+        if (!any) {
+            summary.converged = true;
+            break;
+        }
+        // both buffers have to hold the new sketches before the next round
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            for (size_t v = from; v < to; v++) {
+                if (changed_next[v])
+                    std::copy(&next[v * m], &next[v * m] + m, &current[v * m]);
+            }
+        });
+        changed.swap(changed_next);
+        summary.pairs.push_back(total());
+    }
+
+    // interpolate the hop count at which the share of pairs is reached
+    double target = EFFECTIVE_DIAMETER_SHARE * summary.pairs.back();
+    for (size_t t = 0; t < summary.pairs.size(); t++) {
+        if (summary.pairs[t] < target) continue;
+        double below = t ? summary.pairs[t - 1] : 0;
+        double step = summary.pairs[t] - below;
+        summary.effective_diameter =
+            t ? t - 1 + (step > 0 ? (target - below) / step : 1) : 0;
+        break;
+    }
+    if (function) *function = summary;
+    return size;
+}
+
+double *get_neighborhood_sizes(Graph &graph, uint32_t *list_of_vertices,
+                               uint32_t max_hops,
+                               NeighborhoodFunction &function) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<double> size = hyper_anf(*csr, max_hops, 6, &function);
+
+    double *result = new double[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < size.size() ? size[v] : 0;
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
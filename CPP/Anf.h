@@ -0,0 +1,92 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef ANF_H_
+#define ANF_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/// Share of the reachable pairs the effective diameter covers.
+#define EFFECTIVE_DIAMETER_SHARE 0.9
+
+/**
+ * @brief Approximate neighborhood function of a graph.
+ */
+struct NeighborhoodFunction {
+    /// Estimated number of pairs (v, u) with u within t hops of v, for
+    /// t = 0, 1, ...
+    std::vector<double> pairs;
+    /// Hops within which EFFECTIVE_DIAMETER_SHARE of the pairs reachable
+    /// after the last iteration are reached, interpolated between
+    /// iterations.
+    double effective_diameter = 0;
+    bool converged = false;  ///< No estimate changed in the last iteration.
+};
+
+/**
+ * @brief Estimates how many vertices every vertex reaches, with HyperANF.
+ *
+ * Every vertex keeps a HyperLogLog sketch of the vertices within t hops
+ * along its outbound edges, starting with itself. An iteration replaces
+ * it by its union with the sketches of its children, which is a
+ * register-wise maximum (16 registers at a time with SSE2). A vertex is
+ * only recomputed when one of its children changed in the previous
+ * iteration. Iterations run in parallel over vertices, cost O(m 2^b), and
+ * need two sketches of 2^b bytes per vertex; estimates have a relative
+ * standard error of about 1.04 / sqrt(2^b).
+ *
+ * @param csr            The graph.
+ * @param max_hops       Number of iterations after which the search stops
+ * even if the sketches still change.
+ * @param registers_log2 b, from 4 to 16.
+ * @param function       If not null, filled with the neighborhood function
+ * and the effective diameter.
+ * @return std::vector<double> Estimated number of vertices within
+ * max_hops of every vertex, itself included; 0 for IDs not in use.
+ */
+std::vector<double> hyper_anf(const CsrGraph &csr, uint32_t max_hops,
+                              uint32_t registers_log2 = 6,
+                              NeighborhoodFunction *function = nullptr);
+
+/**
+ * @brief Retrieves the estimated neighborhood sizes of a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param list_of_vertices Pointer to the list of vertices.
+ * @param max_hops         Radius of the neighborhoods.
+ * @param function         Filled with the neighborhood function.
+ * @return double* Dynamically allocated array with the number of vertices
+ * in the first cell and their neighborhood sizes after it (0 for vertices
+ * not in the graph).
+ */
+double *get_neighborhood_sizes(Graph &graph, uint32_t *list_of_vertices,
+                               uint32_t max_hops,
+                               NeighborhoodFunction &function);
+
+#endif  // ANF_H_
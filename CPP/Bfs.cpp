@@ -0,0 +1,382 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Bfs.h"
+#include "Csr.h"
+#include "Data.h"
+#include "Metrics.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+// Switching thresholds from Beamer et al., "Direction-Optimizing
+// Breadth-First Search": go bottom-up once the frontier's edges exceed
+// 1/ALPHA of the unexplored ones, and back once it holds fewer than 1/BETA
+// of the vertices.
+#define BFS_ALPHA 14
+#define BFS_BETA 24
+
+static inline bool test_bit(const std::vector<uint64_t> &bits, uint32_t v) {
+    return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+std::vector<uint32_t> bfs_hops(const CsrGraph &csr, uint32_t source,
+                               uint32_t max_hops) {
+    uint32_t n = csr.n;
+    std::vector<uint32_t> hops(n, UINT32_MAX);
+    if (source >= n || !csr.present[source]) return hops;
+
+    size_t words = (static_cast<size_t>(n) + 63) / 64;
+    std::vector<std::atomic<uint64_t>> visited(words);
+    for (auto &word : visited) word.store(0, std::memory_order_relaxed);
+    std::vector<uint64_t> front_bits(words, 0), next_bits(words, 0);
+
+    std::vector<uint32_t> frontier(1, source), next;
+    hops[source] = 0;
+    visited[source >> 6].store(1ull << (source & 63));
+
+    uint64_t unexplored_edges = csr.m;
+    uint64_t frontier_edges =
+        csr.out_offsets[source + 1] - csr.out_offsets[source];
+    uint64_t frontier_size = 1;
+    bool bottom_up = false;
+    std::mutex merge;
+
+    for (uint32_t level = 1; frontier_size > 0 && level <= max_hops;
+         level++) {
+        if (!bottom_up && frontier_edges > unexplored_edges / BFS_ALPHA) {
+            // the frontier is big: switch to pulling, frontier as a bitmap
+            bottom_up = true;
+            std::fill(front_bits.begin(), front_bits.end(), 0);
+            for (uint32_t v : frontier) front_bits[v >> 6] |= 1ull << (v & 63);
+        } else if (bottom_up && frontier_size < n / BFS_BETA) {
+            // the frontier is small again: switch back to pushing
+            bottom_up = false;
+            frontier.clear();
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = front_bits[w]; bits; bits &= bits - 1)
+                    frontier.push_back(
+                        static_cast<uint32_t>(w * 64 + __builtin_ctzll(bits)));
+            }
+        }
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+
+        std::atomic<uint64_t> found(0), found_edges(0);
+        if (!bottom_up) {
+            next.clear();
+            parallel_for(
+                0, frontier.size(),
+                [&](size_t from, size_t to) {
+                    std::vector<uint32_t> local;
+                    uint64_t local_edges = 0;
+                    for (size_t i = from; i < to; i++) {
+                        uint32_t v = frontier[i];
+                        for (uint64_t e = csr.out_offsets[v];
+                             e < csr.out_offsets[v + 1]; e++) {
+                            uint32_t u = csr.out_targets[e];
+                            uint64_t mask = 1ull << (u & 63);
+                            if (visited[u >> 6].load(
+                                    std::memory_order_relaxed) &
+                                mask)
+                                continue;
+                            // only the thread that sets the bit claims u
+                            if (visited[u >> 6].fetch_or(mask) & mask)
+                                continue;
+                            hops[u] = level;
+                            local.push_back(u);
+                            local_edges +=
+                                csr.out_offsets[u + 1] - csr.out_offsets[u];
+                        }
+                    }
+                    found_edges += local_edges;
+                    std::lock_guard<std::mutex> lock(merge);
+                    next.insert(next.end(), local.begin(), local.end());
+                },
+                256);
+            frontier.swap(next);
+            found = frontier.size();
+        } else {
+            // every thread owns whole words of the bitmaps, so the bottom-up
+            // step needs no atomic updates
+            parallel_for(
+                0, words,
+                [&](size_t from, size_t to) {
+                    uint64_t local = 0, local_edges = 0;
+                    for (size_t w = from; w < to; w++) {
+                        uint64_t seen =
+                            visited[w].load(std::memory_order_relaxed);
+                        uint64_t word = 0;
+                        for (uint32_t b = 0; b < 64; b++) {
+                            size_t v = w * 64 + b;
+                            if (v >= n) break;
+                            if ((seen >> b) & 1 || !csr.present[v]) continue;
+                            for (uint64_t e = csr.in_offsets[v];
+                                 e < csr.in_offsets[v + 1]; e++) {
+                                if (test_bit(front_bits, csr.in_sources[e])) {
+                                    word |= 1ull << b;
+                                    hops[v] = level;
+                                    local++;
+                                    local_edges += csr.out_offsets[v + 1] -
+                                                   csr.out_offsets[v];
+                                    break;
+                                }
+                            }
+                        }
+                        next_bits[w] = word;
+                        visited[w].store(seen | word,
+                                         std::memory_order_relaxed);
+                    }
+                    found += local;
+                    found_edges += local_edges;
+                },
+                64);
+            front_bits.swap(next_bits);
+        }
+        frontier_size = found.load();
+        frontier_edges = found_edges.load();
+    }
+    return hops;
+}
+
+// Runs one batch of at most MS_BFS_LANES sources; lane l of the bit sets is
+// sources[first + l]. `slot` maps a vertex to its column in `dist`.
+static void ms_bfs_batch(const CsrGraph &csr,
+                         const std::vector<uint32_t> &sources, size_t first,
+                         size_t lanes, const std::vector<uint32_t> &slot,
+                         size_t columns, uint32_t max_hops,
+                         std::vector<uint32_t> &dist) {
+    uint32_t n = csr.n;
+    const size_t W = (lanes + 63) / 64;  // words per vertex
+    std::vector<uint64_t> seen(n * W, 0), visit(n * W, 0);
+    std::vector<std::atomic<uint64_t>> next(n * W);
+    for (auto &word : next) word.store(0, std::memory_order_relaxed);
+    std::vector<std::atomic<uint8_t>> touched(n);
+    for (auto &flag : touched) flag.store(0, std::memory_order_relaxed);
+    uint64_t full[MS_BFS_LANES / 64];
+    for (size_t w = 0; w < W; w++) {
+        size_t bits = std::min<size_t>(64, lanes - w * 64);
+        full[w] = bits == 64 ? ~0ull : (1ull << bits) - 1;
+    }
+
+    auto record = [&](uint32_t v, size_t w, uint64_t bits, uint32_t level) {
+        if (slot[v] == UINT32_MAX) return;
+        for (; bits; bits &= bits - 1) {
+            size_t lane = w * 64 + __builtin_ctzll(bits);
+            dist[(first + lane) * columns + slot[v]] = level;
+        }
+    };
+
+    std::vector<uint32_t> frontier, candidates;
+    for (size_t lane = 0; lane < lanes; lane++) {
+        uint32_t s = sources[first + lane];
+        if (s >= n || !csr.present[s]) continue;
+        uint64_t bit = 1ull << (lane & 63);
+        seen[s * W + lane / 64] |= bit;
+        visit[s * W + lane / 64] |= bit;
+        record(s, lane / 64, bit, 0);
+        if (!touched[s].exchange(1)) frontier.push_back(s);
+    }
+    for (uint32_t s : frontier) touched[s].store(0);
+
+    std::mutex merge;
+    for (uint32_t level = 1; !frontier.empty() && level <= max_hops;
+         level++) {
+        uint64_t frontier_edges = 0;
+        for (uint32_t v : frontier)
+            frontier_edges += csr.out_offsets[v + 1] - csr.out_offsets[v];
+
+        candidates.clear();
+        if (frontier_edges <= csr.m / BFS_ALPHA) {
+            parallel_for(
+                0, frontier.size(),
+                [&](size_t from, size_t to) {
+                    std::vector<uint32_t> local;
+                    for (size_t i = from; i < to; i++) {
+                        uint32_t v = frontier[i];
+                        for (uint64_t e = csr.out_offsets[v];
+                             e < csr.out_offsets[v + 1]; e++) {
+                            uint32_t u = csr.out_targets[e];
+                            bool any = false;
+                            for (size_t w = 0; w < W; w++) {
+                                uint64_t bits =
+                                    visit[v * W + w] & ~seen[u * W + w];
+                                if (!bits) continue;
+                                next[u * W + w].fetch_or(
+                                    bits, std::memory_order_relaxed);
+                                any = true;
+                            }
+                            if (any && !touched[u].exchange(1))
+                                local.push_back(u);
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(merge);
+                    candidates.insert(candidates.end(), local.begin(),
+                                      local.end());
+                },
+                64);
+        } else {
+            // every vertex writes only its own bits, so pulling needs no
+            // read-modify-write atomics
+            parallel_for(0, n, [&](size_t from, size_t to) {
+                std::vector<uint32_t> local;
+                uint64_t acc[MS_BFS_LANES / 64];
+                for (size_t u = from; u < to; u++) {
+                    bool open = false;
+                    for (size_t w = 0; w < W; w++)
+                        open |= seen[u * W + w] != full[w];
+                    if (!open || !csr.present[u]) continue;
+                    for (size_t w = 0; w < W; w++) acc[w] = 0;
+                    for (uint64_t e = csr.in_offsets[u];
+                         e < csr.in_offsets[u + 1]; e++) {
+                        const uint64_t *parent = &visit[csr.in_sources[e] * W];
+                        for (size_t w = 0; w < W; w++) acc[w] |= parent[w];
+                    }
+                    bool any = false;
+                    for (size_t w = 0; w < W; w++) {
+                        acc[w] &= ~seen[u * W + w];
+                        next[u * W + w].store(acc[w],
+                                              std::memory_order_relaxed);
+                        any |= acc[w] != 0;
+                    }
+                    if (any) {
+                        touched[u].store(1, std::memory_order_relaxed);
+                        local.push_back(static_cast<uint32_t>(u));
+                    }
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                candidates.insert(candidates.end(), local.begin(),
+                                  local.end());
+            });
+        }
+
+        parallel_for(0, frontier.size(), [&](size_t from, size_t to) {
+            for (size_t i = from; i < to; i++) {
+                for (size_t w = 0; w < W; w++) visit[frontier[i] * W + w] = 0;
+            }
+        });
+        frontier.clear();
+        parallel_for(
+            0, candidates.size(),
+            [&](size_t from, size_t to) {
+                std::vector<uint32_t> local;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t u = candidates[i];
+                    touched[u].store(0, std::memory_order_relaxed);
+                    bool any = false;
+                    for (size_t w = 0; w < W; w++) {
+                        uint64_t bits = next[u * W + w].exchange(
+                                            0, std::memory_order_relaxed) &
+                                        ~seen[u * W + w];
+                        visit[u * W + w] = bits;
+                        seen[u * W + w] |= bits;
+                        record(u, w, bits, level);
+                        any |= bits != 0;
+                    }
+                    if (any) local.push_back(u);
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                frontier.insert(frontier.end(), local.begin(), local.end());
+            },
+            256);
+    }
+}
+
+std::vector<uint32_t> multi_source_hops(const CsrGraph &csr,
+                                        const std::vector<uint32_t> &sources,
+                                        const std::vector<uint32_t> &targets,
+                                        uint32_t max_hops) {
+    size_t columns = targets.size();
+    std::vector<uint32_t> dist(sources.size() * columns, UINT32_MAX);
+    // repeated targets are filled from their first occurrence afterwards
+    std::vector<uint32_t> slot(csr.n, UINT32_MAX);
+    for (size_t j = 0; j < columns; j++) {
+        uint32_t t = targets[j];
+        if (t < csr.n && slot[t] == UINT32_MAX)
+            slot[t] = static_cast<uint32_t>(j);
+    }
+
+    for (size_t first = 0; first < sources.size(); first += MS_BFS_LANES) {
+        size_t lanes = std::min<size_t>(MS_BFS_LANES, sources.size() - first);
+        ms_bfs_batch(csr, sources, first, lanes, slot, columns, max_hops,
+                     dist);
+    }
+
+    for (size_t j = 0; j < columns; j++) {
+        uint32_t t = targets[j];
+        if (t >= csr.n || slot[t] == j) continue;
+        for (size_t i = 0; i < sources.size(); i++)
+            dist[i * columns + j] = dist[i * columns + slot[t]];
+    }
+    return dist;
+}
+
+uint32_t *get_hop_distances(Graph &graph, uint32_t source,
+                            uint32_t *list_of_vertices, uint32_t max_hops,
+                            uint32_t &reached) {
+    OperationTimer timer(OPERATION_HOP_DISTANCES);
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<uint32_t> hops = bfs_hops(*csr, source, max_hops);
+
+    reached = 0;
+    for (uint32_t h : hops) reached += h != UINT32_MAX;
+    timer.items = reached;
+
+    uint32_t *result = new uint32_t[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < hops.size() ? hops[v] : UINT32_MAX;
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
+
+uint32_t *get_multi_hop_distances(Graph &graph, uint32_t *sources,
+                                  uint32_t *targets) {
+    OperationTimer timer(OPERATION_MULTI_HOP_DISTANCES);
+    std::vector<uint32_t> source_list, target_list;
+    for (uint16_t i = 0; i < MAX_OPERATON_BUFFER && sources[i] != UINT32_MAX;
+         i++)
+        source_list.push_back(sources[i]);
+    for (uint16_t i = 0; i < MAX_OPERATON_BUFFER && targets[i] != UINT32_MAX;
+         i++)
+        target_list.push_back(targets[i]);
+
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<uint32_t> dist =
+        multi_source_hops(*csr, source_list, target_list);
+
+    uint32_t *result = new uint32_t[dist.size() + 1];
+    result[0] = static_cast<uint32_t>(dist.size());
+    std::copy(dist.begin(), dist.end(), result + 1);
+    timer.items = dist.size();
+    return result;
+}
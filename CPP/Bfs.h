@@ -0,0 +1,109 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef BFS_H_
+#define BFS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/// Number of sources searched together by multi_source_hops().
+#define MS_BFS_LANES 256
+
+/**
+ * @brief Computes hop distances from a vertex with a parallel BFS.
+ *
+ * Uses direction-optimizing BFS: small frontiers are expanded top-down by
+ * pushing along the outbound lists, and once the frontier touches a large
+ * share of the remaining edges the search switches to bottom-up, where every
+ * unvisited vertex pulls along its inbound list until it finds a parent in
+ * the frontier. Frontiers and the visited set are kept as bitmaps.
+ *
+ * @param csr      The graph.
+ * @param source   The vertex to start from.
+ * @param max_hops Number of levels after which the search stops.
+ * @return std::vector<uint32_t> Hops from the source to every vertex,
+ * UINT32_MAX for vertices not reached within max_hops.
+ */
+std::vector<uint32_t> bfs_hops(const CsrGraph &csr, uint32_t source,
+                               uint32_t max_hops = UINT32_MAX);
+
+/**
+ * @brief Computes hop distances from many sources in one traversal.
+ *
+ * Multi-source BFS: every vertex keeps one bit per source in its seen,
+ * frontier and next sets, so a single pass over the adjacency lists
+ * advances all searches at once and work shared between sources is done
+ * once. Sources are processed in batches of up to MS_BFS_LANES; each level
+ * either pushes the frontier's bits along the outbound lists or, once the
+ * frontier is large, lets every vertex pull the bits of its parents.
+ *
+ * @param csr      The graph.
+ * @param sources  The vertices to start from.
+ * @param targets  The vertices to report distances for.
+ * @param max_hops Number of levels after which the search stops.
+ * @return std::vector<uint32_t> Hops from `sources[i]` to `targets[j]` at
+ * index `i * targets.size() + j`, UINT32_MAX when not reachable within
+ * max_hops.
+ */
+std::vector<uint32_t> multi_source_hops(const CsrGraph &csr,
+                                        const std::vector<uint32_t> &sources,
+                                        const std::vector<uint32_t> &targets,
+                                        uint32_t max_hops = UINT32_MAX);
+
+/**
+ * @brief Retrieves the hop distances from a vertex to a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param source           The vertex to start from.
+ * @param list_of_vertices Pointer to the list of target vertices.
+ * @param max_hops         Number of levels after which the search stops.
+ * @param reached          Set to the number of vertices reached, including
+ * the source.
+ * @return uint32_t* Dynamically allocated array with the number of targets
+ * in the first cell and their hop distances after it (UINT32_MAX when not
+ * reachable within max_hops).
+ */
+uint32_t *get_hop_distances(Graph &graph, uint32_t source,
+                            uint32_t *list_of_vertices, uint32_t max_hops,
+                            uint32_t &reached);
+
+/**
+ * @brief Retrieves the hop distances between two sets of vertices.
+ *
+ * @param graph   The graph.
+ * @param sources Pointer to the list of source vertices.
+ * @param targets Pointer to the list of target vertices.
+ * @return uint32_t* Dynamically allocated array with the number of pairs in
+ * the first cell, followed by the hop distances from the first source to
+ * every target, then from the second source, and so on (UINT32_MAX when
+ * not reachable).
+ */
+uint32_t *get_multi_hop_distances(Graph &graph, uint32_t *sources,
+                                  uint32_t *targets);
+
+#endif  // BFS_H_
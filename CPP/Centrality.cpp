@@ -0,0 +1,292 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Centrality.h"
+#include "Csr.h"
+#include "Data.h"
+#include "Parallel.h"
+#include "ShortestPath.h"
+#include "Structures.h"
+
+#define NOT_QUEUED UINT32_MAX
+
+// Binary heap of vertices keyed by their distance, with decrease-key, so it
+// never holds more than one entry per vertex
+struct IndexedHeap {
+    std::vector<uint32_t> heap;
+    std::vector<uint32_t> position;  // index in heap, NOT_QUEUED if absent
+    const std::vector<uint64_t> *key = nullptr;
+
+    void move(size_t i, uint32_t v) {
+        heap[i] = v;
+        position[v] = static_cast<uint32_t>(i);
+    }
+
+    void sift_up(size_t i) {
+        uint32_t v = heap[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if ((*key)[heap[parent]] <= (*key)[v]) break;
+            move(i, heap[parent]);
+            i = parent;
+        }
+        move(i, v);
+    }
+
+    void push_or_decrease(uint32_t v) {
+        if (position[v] == NOT_QUEUED) {
+            heap.push_back(v);
+            position[v] = static_cast<uint32_t>(heap.size() - 1);
+        }
+        sift_up(position[v]);
+    }
+
+    uint32_t pop() {
+        uint32_t top = heap[0];
+        position[top] = NOT_QUEUED;
+        uint32_t v = heap.back();
+        heap.pop_back();
+        if (heap.empty()) return top;
+        size_t i = 0, size = heap.size();
+        while (true) {
+            size_t child = 2 * i + 1;
+            if (child >= size) break;
+            if (child + 1 < size &&
+                (*key)[heap[child + 1]] < (*key)[heap[child]])
+                child++;
+            if ((*key)[v] <= (*key)[heap[child]]) break;
+            move(i, heap[child]);
+            i = child;
+        }
+        move(i, v);
+        return top;
+    }
+};
+
+// Per-thread state: the search arrays are reset after every source through
+// `order`, `score` accumulates over all sources the thread handles
+struct BrandesSpace {
+    std::vector<uint64_t> dist;
+    std::vector<double> paths;
+    std::vector<double> dependency;
+    std::vector<double> score;
+    std::vector<uint32_t> order;  // reached vertices by distance
+    IndexedHeap heap;
+
+    explicit BrandesSpace(uint32_t n)
+        : dist(n, UNREACHABLE), paths(n, 0), dependency(n, 0), score(n, 0) {
+        heap.position.assign(n, NOT_QUEUED);
+        heap.key = &dist;
+    }
+};
+
+class BrandesPool {
+ public:
+    explicit BrandesPool(uint32_t n) : n_(n) {}
+
+    BrandesSpace *acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            all_.emplace_back(new BrandesSpace(n_));
+            return all_.back().get();
+        }
+        BrandesSpace *space = free_.back();
+        free_.pop_back();
+        return space;
+    }
+
+    void release(BrandesSpace *space) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(space);
+    }
+
+    const std::vector<std::unique_ptr<BrandesSpace>> &all() const {
+        return all_;
+    }
+
+ private:
+    uint32_t n_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<BrandesSpace>> all_;
+    std::vector<BrandesSpace *> free_;
+};
+
+// Fills dist, paths and order from `source`
+static void count_paths(const CsrGraph &csr, bool weighted, uint32_t source,
+                        BrandesSpace &space) {
+    std::vector<uint64_t> &dist = space.dist;
+    std::vector<double> &paths = space.paths;
+    std::vector<uint32_t> &order = space.order;
+    dist[source] = 0;
+    paths[source] = 1;
+
+    if (!weighted) {
+        // the order array doubles as the BFS queue
+        order.push_back(source);
+        for (size_t head = 0; head < order.size(); head++) {
+            uint32_t v = order[head];
+            for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+                 e++) {
+                uint32_t u = csr.out_targets[e];
+                if (dist[u] == UNREACHABLE) {
+                    dist[u] = dist[v] + 1;
+                    order.push_back(u);
+                }
+                if (dist[u] == dist[v] + 1) paths[u] += paths[v];
+            }
+        }
+        return;
+    }
+
+    // the path count of a vertex is final once it is settled, as all its
+    // predecessors on shortest paths are settled before it
+    IndexedHeap &heap = space.heap;
+    heap.push_or_decrease(source);
+    while (!heap.heap.empty()) {
+        uint32_t v = heap.pop();
+        order.push_back(v);
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            uint64_t candidate = dist[v] + csr.out_weights[e];
+            if (candidate < dist[u]) {
+                dist[u] = candidate;
+                paths[u] = paths[v];
+                heap.push_or_decrease(u);
+            } else if (candidate == dist[u] && heap.position[u] != NOT_QUEUED) {
+                paths[u] += paths[v];
+            }
+        }
+    }
+}
+
+// Walks `order` backwards adding the dependency of the source on every
+// vertex to its score, then clears the search arrays
+static void accumulate(const CsrGraph &csr, bool weighted, double scale,
+                       BrandesSpace &space) {
+    std::vector<uint64_t> &dist = space.dist;
+    std::vector<double> &paths = space.paths;
+    std::vector<double> &dependency = space.dependency;
+    std::vector<uint32_t> &order = space.order;
+    for (size_t i = order.size(); i-- > 1;) {
+        uint32_t w = order[i];
+        double share = (1 + dependency[w]) / paths[w];
+        for (uint64_t e = csr.in_offsets[w]; e < csr.in_offsets[w + 1]; e++) {
+            uint32_t v = csr.in_sources[e];
+            if (dist[v] == UNREACHABLE) continue;
+            uint64_t length = weighted ? csr.in_weights[e] : 1;
+            if (dist[v] + length == dist[w] && v != w)
+                dependency[v] += paths[v] * share;
+        }
+        space.score[w] += scale * dependency[w];
+    }
+    for (uint32_t v : order) {
+        dist[v] = UNREACHABLE;
+        paths[v] = 0;
+        dependency[v] = 0;
+    }
+    order.clear();
+}
+
+std::vector<double> betweenness(const CsrGraph &csr, bool weighted,
+                                uint32_t samples, uint64_t seed,
+                                BetweennessStats *stats) {
+    uint32_t n = csr.n;
+    std::vector<uint32_t> sources;
+    for (uint32_t v = 0; v < n; v++) {
+        if (csr.present[v]) sources.push_back(v);
+    }
+    uint64_t count = sources.size();
+    bool exact = samples == 0 || samples >= count;
+    double scale = 1;
+    if (!exact) {
+        std::mt19937_64 random(seed);
+        std::vector<uint32_t> drawn(samples);
+        for (uint32_t &v : drawn) v = sources[random() % count];
+        sources.swap(drawn);
+        scale = static_cast<double>(count) / samples;
+    }
+
+    BrandesPool pool(n);
+    parallel_for(
+        0, sources.size(),
+        [&](size_t from, size_t to) {
+            BrandesSpace *space = pool.acquire();
+            for (size_t i = from; i < to; i++) {
+                count_paths(csr, weighted, sources[i], *space);
+                accumulate(csr, weighted, scale, *space);
+            }
+            pool.release(space);
+        },
+        1);
+
+    std::vector<double> score(n, 0);
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (const auto &space : pool.all()) {
+            for (size_t v = from; v < to; v++) score[v] += space->score[v];
+        }
+    });
+
+    if (stats) {
+        stats->sources = static_cast<uint32_t>(sources.size());
+        stats->exact = exact;
+        stats->error_bound = 0;
+        if (!exact && count > 2) {
+            double range = static_cast<double>(count) * (count - 2);
+            stats->error_bound =
+                range * std::sqrt(std::log(2 * count /
+                                           (1 - BETWEENNESS_CONFIDENCE)) /
+                                  (2.0 * samples));
+        }
+    }
+    return score;
+}
+
+double *get_betweenness(Graph &graph, uint32_t *list_of_vertices,
+                        bool weighted, uint32_t samples,
+                        BetweennessStats &stats) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<double> score =
+        betweenness(*csr, weighted, samples, 1, &stats);
+
+    double *result = new double[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < score.size() ? score[v] : 0;
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
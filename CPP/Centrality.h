@@ -0,0 +1,98 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef CENTRALITY_H_
+#define CENTRALITY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/// Probability with which a sampled estimate stays within its error bound.
+#define BETWEENNESS_CONFIDENCE 0.95
+
+/**
+ * @brief Summary of a betweenness computation.
+ */
+struct BetweennessStats {
+    uint32_t sources = 0;      ///< Number of searches run.
+    bool exact = true;         ///< Every vertex was used as a source.
+    double error_bound = 0;    ///< Bound on the error of every estimate.
+};
+
+/**
+ * @brief Computes the betweenness centrality of every vertex.
+ *
+ * Brandes' algorithm: a search from every source counts the shortest paths
+ * to each vertex, then walks the vertices back in order of distance
+ * accumulating the dependency of the source on each of them. Searches run
+ * in parallel, each thread keeping its own distances, path counts,
+ * dependencies and scores, so memory per thread is O(V). Predecessors are
+ * not stored: they are found again on the inbound lists as the parents
+ * whose distance plus edge weight matches.
+ *
+ * With `samples` below the number of vertices, that many sources are drawn
+ * uniformly with replacement and the scores are scaled up accordingly. By
+ * Hoeffding's inequality and a union bound over the vertices, with
+ * probability BETWEENNESS_CONFIDENCE every estimate is then within
+ * `n (n - 2) sqrt(ln(2n / (1 - BETWEENNESS_CONFIDENCE)) / (2 samples))` of
+ * the exact value.
+ *
+ * Weighted searches use Dijkstra's algorithm with an indexed heap. Paths
+ * through edges of weight 0 are only counted when the edge's tail is
+ * settled before its head.
+ *
+ * @param csr      The graph.
+ * @param weighted Use the edge weights instead of hop counts.
+ * @param samples  Number of sources to sample, 0 for the exact values.
+ * @param seed     Seed for drawing the sources.
+ * @param stats    If not null, filled with a summary of the computation.
+ * @return std::vector<double> Number of shortest paths between other
+ * vertices passing through every vertex, each path between two vertices
+ * counting as its share of all shortest paths between them.
+ */
+std::vector<double> betweenness(const CsrGraph &csr, bool weighted,
+                                uint32_t samples = 0, uint64_t seed = 1,
+                                BetweennessStats *stats = nullptr);
+
+/**
+ * @brief Retrieves the betweenness centrality of a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param list_of_vertices Pointer to the list of vertices.
+ * @param weighted         Use the edge weights.
+ * @param samples          Number of sources to sample, 0 for exact values.
+ * @param stats            Filled with a summary of the computation.
+ * @return double* Dynamically allocated array with the number of vertices
+ * in the first cell and their centrality after it (0 for vertices not in
+ * the graph).
+ */
+double *get_betweenness(Graph &graph, uint32_t *list_of_vertices,
+                        bool weighted, uint32_t samples,
+                        BetweennessStats &stats);
+
+#endif  // CENTRALITY_H_
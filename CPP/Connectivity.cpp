@@ -0,0 +1,229 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Connectivity.h"
+#include "Csr.h"
+#include "Structures.h"
+
+#define NO_COMPONENT UINT32_MAX
+
+static void reserve_vertex(ConnectivityIndex &index, uint32_t vertex) {
+    if (vertex < index.label.size()) return;
+    size_t grown = std::max<size_t>(vertex + 1, index.label.size() * 2);
+    index.label.resize(grown, NO_COMPONENT);
+    index.seen.resize(grown, 0);
+}
+
+static uint32_t new_label(ConnectivityIndex &index) {
+    index.components++;
+    if (!index.free_labels.empty()) {
+        uint32_t label = index.free_labels.back();
+        index.free_labels.pop_back();
+        return label;
+    }
+    index.size.push_back(0);
+    return static_cast<uint32_t>(index.size.size() - 1);
+}
+
+static void drop_label(ConnectivityIndex &index, uint32_t label) {
+    index.components--;
+    index.free_labels.push_back(label);
+}
+
+// Calls visit(u) for every parent and child u of v
+template <typename Visit>
+static void for_each_neighbor(const AdjacencyMap &outbound,
+                              const AdjacencyMap &inbound, uint32_t v,
+                              Visit visit) {
+    for (const AdjacencyMap *map : {&outbound, &inbound}) {
+        auto it = map->find(v);
+        if (it == map->end()) continue;
+        const uint32_t *list = it->second;
+        for (uint32_t j = 1; j <= list[0]; j++) visit(list[j]);
+    }
+}
+
+// Moves the vertices labeled `from` that are reachable from `start` to
+// `to`
+static uint32_t relabel(ConnectivityIndex &index, const AdjacencyMap &outbound,
+                        const AdjacencyMap &inbound, uint32_t start,
+                        uint32_t from, uint32_t to) {
+    std::vector<uint32_t> queue(1, start);
+    index.label[start] = to;
+    for (size_t head = 0; head < queue.size(); head++) {
+        for_each_neighbor(outbound, inbound, queue[head], [&](uint32_t u) {
+            if (u >= index.label.size() || index.label[u] != from) return;
+            index.label[u] = to;
+            queue.push_back(u);
+        });
+    }
+    return static_cast<uint32_t>(queue.size());
+}
+
+// Searches from a and b, of the same component, one vertex at a time from
+// each side; if one side runs out before they meet, it becomes a new
+// component. Returns whether a and b are still connected.
+static bool split(ConnectivityIndex &index, const AdjacencyMap &outbound,
+                  const AdjacencyMap &inbound, uint32_t a, uint32_t b) {
+    if (a == b) return true;
+    uint32_t label = index.label[a];
+    if (index.stamp >= UINT32_MAX - 2) {
+        std::fill(index.seen.begin(), index.seen.end(), 0);
+        index.stamp = 0;
+    }
+    index.stamp += 2;
+    uint32_t mark[2] = {index.stamp, index.stamp + 1};
+    std::vector<uint32_t> queue[2] = {{a}, {b}};
+    size_t head[2] = {0, 0};
+    index.seen[a] = mark[0];
+    index.seen[b] = mark[1];
+
+    for (int side = 0;; side ^= 1) {
+        if (head[side] == queue[side].size()) {
+            uint32_t fresh = new_label(index);
+            for (uint32_t v : queue[side]) index.label[v] = fresh;
+            index.size[fresh] = static_cast<uint32_t>(queue[side].size());
+            index.size[label] -= index.size[fresh];
+            return false;
+        }
+        bool met = false;
+        for_each_neighbor(
+            outbound, inbound, queue[side][head[side]++], [&](uint32_t u) {
+                if (met || u >= index.label.size() || index.label[u] != label)
+                    return;
+                if (index.seen[u] == mark[side ^ 1]) {
+                    met = true;
+                } else if (index.seen[u] != mark[side]) {
+                    index.seen[u] = mark[side];
+                    queue[side].push_back(u);
+                }
+            });
+        if (met) return true;
+    }
+}
+
+std::shared_ptr<ConnectivityIndex> build_connectivity(const CsrGraph &csr) {
+    std::shared_ptr<ConnectivityIndex> index =
+        std::make_shared<ConnectivityIndex>();
+    index->label.assign(csr.n, NO_COMPONENT);
+    index->seen.assign(csr.n, 0);
+    std::vector<uint32_t> queue;
+    for (uint32_t s = 0; s < csr.n; s++) {
+        if (!csr.present[s] || index->label[s] != NO_COMPONENT) continue;
+        uint32_t label = new_label(*index);
+        queue.assign(1, s);
+        index->label[s] = label;
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t v = queue[head];
+            auto visit = [&](uint32_t u) {
+                if (index->label[u] != NO_COMPONENT) return;
+                index->label[u] = label;
+                queue.push_back(u);
+            };
+            for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+                 e++)
+                visit(csr.out_targets[e]);
+            for (uint64_t e = csr.in_offsets[v]; e < csr.in_offsets[v + 1];
+                 e++)
+                visit(csr.in_sources[e]);
+        }
+        index->size[label] = static_cast<uint32_t>(queue.size());
+    }
+    return index;
+}
+
+std::shared_ptr<ConnectivityIndex> get_connectivity(Graph &graph) {
+    if (!graph.connectivity)
+        graph.connectivity = build_connectivity(*get_csr(graph));
+    return graph.connectivity;
+}
+
+bool connected(const ConnectivityIndex &index, uint32_t u, uint32_t v) {
+    return u < index.label.size() && v < index.label.size() &&
+           index.label[u] != NO_COMPONENT && index.label[u] == index.label[v];
+}
+
+void connectivity_add_vertex(ConnectivityIndex &index, uint32_t vertex) {
+    reserve_vertex(index, vertex);
+    uint32_t label = new_label(index);
+    index.label[vertex] = label;
+    index.size[label] = 1;
+}
+
+void connectivity_add_edge(ConnectivityIndex &index,
+                           const AdjacencyMap &outbound,
+                           const AdjacencyMap &inbound, uint32_t parent,
+                           uint32_t child) {
+    uint32_t a = index.label[parent], b = index.label[child];
+    if (a == b) return;
+    // the smaller component takes the label of the larger one
+    if (index.size[a] < index.size[b]) {
+        std::swap(a, b);
+        std::swap(parent, child);
+    }
+    relabel(index, outbound, inbound, child, b, a);
+    index.size[a] += index.size[b];
+    index.size[b] = 0;
+    drop_label(index, b);
+}
+
+void connectivity_remove_edge(ConnectivityIndex &index,
+                              const AdjacencyMap &outbound,
+                              const AdjacencyMap &inbound, uint32_t parent,
+                              uint32_t child) {
+    if (index.label[parent] != index.label[child]) return;
+    split(index, outbound, inbound, parent, child);
+}
+
+void connectivity_remove_vertex(ConnectivityIndex &index,
+                                const AdjacencyMap &outbound,
+                                const AdjacencyMap &inbound, uint32_t vertex,
+                                const std::vector<uint32_t> &neighbors) {
+    uint32_t label = index.label[vertex];
+    index.label[vertex] = NO_COMPONENT;
+    if (--index.size[label] == 0) {
+        drop_label(index, label);
+        return;
+    }
+
+    // every neighbor still labeled like an earlier one is checked against
+    // those earlier ones until it is found connected to one of them; a
+    // failed check relabels a whole piece, so no piece keeps the label of
+    // another
+    for (size_t i = 1; i < neighbors.size(); i++) {
+        uint32_t v = neighbors[i];
+        if (v == vertex) continue;
+        for (size_t j = 0; j < i; j++) {
+            uint32_t u = neighbors[j];
+            if (u == vertex || index.label[u] != index.label[v]) continue;
+            if (split(index, outbound, inbound, u, v)) break;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef CONNECTIVITY_H_
+#define CONNECTIVITY_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Weakly connected components kept up to date as the graph changes.
+ *
+ * Every vertex carries the label of its component, so whether two vertices
+ * are connected is a single comparison. Adding an edge between two
+ * components merges them union-by-size: the smaller one is relabeled by a
+ * search over its own vertices, so a vertex is relabeled O(log n) times
+ * over any sequence of insertions. Removing an edge inside a component
+ * starts a search from both of its ends, one vertex at a time from each;
+ * they stop as soon as they meet, or as soon as one of them runs out of
+ * vertices, which then form a new component. Searches follow edges in both
+ * directions through the adjacency tables.
+ */
+struct ConnectivityIndex {
+    /// Component of every vertex ID, UINT32_MAX for IDs not in use.
+    std::vector<uint32_t> label;
+    std::vector<uint32_t> size;         ///< Vertices of every label.
+    std::vector<uint32_t> free_labels;  ///< Labels of merged components.
+    uint32_t components = 0;            ///< Number of components.
+    /// Search marks, `stamp` and `stamp + 1` for the two ends of a removed
+    /// edge.
+    std::vector<uint32_t> seen;
+    uint32_t stamp = 0;
+};
+
+/**
+ * @brief Labels the weakly connected components of a graph.
+ * @param csr The graph.
+ * @return std::shared_ptr<ConnectivityIndex> The index.
+ */
+std::shared_ptr<ConnectivityIndex> build_connectivity(const CsrGraph &csr);
+
+/**
+ * @brief Returns the connectivity index of a graph, building it if needed.
+ *
+ * Once built, the index is kept in the graph and updated by the functions
+ * that add and remove vertices and edges.
+ * @param graph The graph.
+ * @return std::shared_ptr<ConnectivityIndex> The index.
+ */
+std::shared_ptr<ConnectivityIndex> get_connectivity(Graph &graph);
+
+/**
+ * @brief Checks whether two vertices are in the same weak component.
+ * @param index The index.
+ * @param u     A vertex.
+ * @param v     Another vertex.
+ * @return bool Both are in the graph and connected.
+ */
+bool connected(const ConnectivityIndex &index, uint32_t u, uint32_t v);
+
+/**
+ * @brief Records a vertex added without edges.
+ * @param index  The index.
+ * @param vertex The new vertex.
+ */
+void connectivity_add_vertex(ConnectivityIndex &index, uint32_t vertex);
+
+/**
+ * @brief Records an edge added to the adjacency tables.
+ * @param index    The index.
+ * @param outbound The outbound table, already holding the edge.
+ * @param inbound  The inbound table, already holding the edge.
+ * @param parent   The parent of the edge.
+ * @param child    The child of the edge.
+ */
+void connectivity_add_edge(ConnectivityIndex &index,
+                           const AdjacencyMap &outbound,
+                           const AdjacencyMap &inbound, uint32_t parent,
+                           uint32_t child);
+
+/**
+ * @brief Records an edge removed from the adjacency tables.
+ * @param index    The index.
+ * @param outbound The outbound table, without the edge.
+ * @param inbound  The inbound table, without the edge.
+ * @param parent   The parent of the edge.
+ * @param child    The child of the edge.
+ */
+void connectivity_remove_edge(ConnectivityIndex &index,
+                              const AdjacencyMap &outbound,
+                              const AdjacencyMap &inbound, uint32_t parent,
+                              uint32_t child);
+
+/**
+ * @brief Records a vertex removed with its edges.
+ *
+ * The component of the vertex may fall apart into as many pieces as it had
+ * neighbors; each piece holds one of them, so checking the neighbors
+ * against one another finds them all.
+ *
+ * @param index     The index.
+ * @param outbound  The outbound table, without the vertex.
+ * @param inbound   The inbound table, without the vertex.
+ * @param vertex    The removed vertex.
+ * @param neighbors Its parents and children.
+ */
+void connectivity_remove_vertex(ConnectivityIndex &index,
+                                const AdjacencyMap &outbound,
+                                const AdjacencyMap &inbound, uint32_t vertex,
+                                const std::vector<uint32_t> &neighbors);
+
+#endif  // CONNECTIVITY_H_
@@ -0,0 +1,191 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Csr.h"
+#include "Numa.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+// Fills one side of the CSR copy from the adjacency lists, `outgoing` tells
+// which end of the edge the list owner is when looking up the weights
+static void fill_side(const std::vector<const uint32_t *> &lists,
+                      const CostMap &costs, bool outgoing,
+                      std::vector<uint64_t> &offsets,
+                      std::vector<uint32_t> &targets,
+                      std::vector<uint32_t> &weights) {
+    size_t n = lists.size();
+    offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; v++)
+        offsets[v + 1] = offsets[v] + (lists[v] ? lists[v][0] : 0);
+    targets.resize(offsets[n]);
+    weights.resize(offsets[n]);
+
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++) {
+            const uint32_t *list = lists[v];
+            if (list == nullptr) continue;
+            uint32_t *begin = targets.data() + offsets[v];
+            std::copy(list + 1, list + 1 + list[0], begin);
+            std::sort(begin, begin + list[0]);
+            uint32_t vertex = static_cast<uint32_t>(v);
+            for (uint32_t j = 0; j < list[0]; j++) {
+                uint32_t u = begin[j];
+                uint32_t parent = outgoing ? vertex : u;
+                uint32_t child = outgoing ? u : vertex;
+                auto it = costs.find({parent, child});
+                weights[offsets[v] + j] = it == costs.end() ? 0 : it->second;
+            }
+        }
+    });
+}
+
+template <typename T>
+static void place_range(const std::vector<T> &values, size_t from, size_t to,
+                        uint32_t node) {
+    if (from < to) numa_place(values.data() + from, values.data() + to, node);
+}
+
+// In NUMA mode, moves the slice of the vertices each node owns in parallel
+// loops, and the edges of those vertices, to the node's memory
+static void place(const CsrGraph &csr) {
+    if (!numa_active()) return;
+    uint32_t workers = worker_count();
+    for (uint32_t k = 0; k < numa_topology().nodes.size(); k++) {
+        size_t from, to;
+        numa_slice(0, csr.n, k, workers, from, to);
+        place_range(csr.present, from, to, k);
+        place_range(csr.out_offsets, from, to, k);
+        place_range(csr.in_offsets, from, to, k);
+        place_range(csr.out_targets, csr.out_offsets[from],
+                    csr.out_offsets[to], k);
+        place_range(csr.out_weights, csr.out_offsets[from],
+                    csr.out_offsets[to], k);
+        place_range(csr.in_sources, csr.in_offsets[from], csr.in_offsets[to],
+                    k);
+        place_range(csr.in_weights, csr.in_offsets[from], csr.in_offsets[to],
+                    k);
+    }
+}
+
+std::shared_ptr<const CsrGraph> build_csr(const Graph &graph) {
+    std::shared_ptr<CsrGraph> csr = std::make_shared<CsrGraph>();
+    uint32_t n = 0;
+    for (const auto &entry : *graph.outbound) n = std::max(n, entry.first + 1);
+    csr->n = n;
+
+    std::vector<const uint32_t *> out_lists(n, nullptr), in_lists(n, nullptr);
+    csr->present.assign(n, 0);
+    for (const auto &entry : *graph.outbound) {
+        out_lists[entry.first] = entry.second;
+        csr->present[entry.first] = 1;
+    }
+    for (const auto &entry : *graph.inbound) {
+        if (entry.first < n) in_lists[entry.first] = entry.second;
+    }
+
+    fill_side(out_lists, *graph.costs, true, csr->out_offsets,
+              csr->out_targets, csr->out_weights);
+    fill_side(in_lists, *graph.costs, false, csr->in_offsets, csr->in_sources,
+              csr->in_weights);
+    csr->m = csr->out_targets.size();
+    place(*csr);
+    return csr;
+}
+
+// Fills one side of a CSR graph from an edge list by counting sort on the
+// owning end, then sorts every list by neighbor
+static void fill_side(uint32_t n, const std::vector<Edge> &edges,
+                      const std::vector<uint32_t> &edge_weights, bool outgoing,
+                      std::vector<uint64_t> &offsets,
+                      std::vector<uint32_t> &targets,
+                      std::vector<uint32_t> &weights) {
+    offsets.assign(static_cast<size_t>(n) + 1, 0);
+    for (const Edge &e : edges) offsets[(outgoing ? e.parent : e.child) + 1]++;
+    for (uint32_t v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+    targets.resize(edges.size());
+    weights.resize(edges.size());
+
+    std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < edges.size(); i++) {
+        const Edge &e = edges[i];
+        uint64_t at = next[outgoing ? e.parent : e.child]++;
+        targets[at] = outgoing ? e.child : e.parent;
+        weights[at] = edge_weights.empty() ? 1 : edge_weights[i];
+    }
+
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        std::vector<std::pair<uint32_t, uint32_t>> list;
+        for (size_t v = from; v < to; v++) {
+            list.clear();
+            for (uint64_t e = offsets[v]; e < offsets[v + 1]; e++)
+                list.emplace_back(targets[e], weights[e]);
+            std::sort(list.begin(), list.end());
+            for (size_t j = 0; j < list.size(); j++) {
+                targets[offsets[v] + j] = list[j].first;
+                weights[offsets[v] + j] = list[j].second;
+            }
+        }
+    });
+}
+
+std::shared_ptr<const CsrGraph> build_csr(
+    uint32_t n, const std::vector<Edge> &edges,
+    const std::vector<uint32_t> &weights) {
+    std::shared_ptr<CsrGraph> csr = std::make_shared<CsrGraph>();
+    csr->n = n;
+    csr->m = edges.size();
+    csr->present.assign(n, 1);
+    fill_side(n, edges, weights, true, csr->out_offsets, csr->out_targets,
+              csr->out_weights);
+    fill_side(n, edges, weights, false, csr->in_offsets, csr->in_sources,
+              csr->in_weights);
+    place(*csr);
+    return csr;
+}
+
+std::shared_ptr<const CsrGraph> reverse_csr(const CsrGraph &csr) {
+    std::shared_ptr<CsrGraph> reversed = std::make_shared<CsrGraph>();
+    reversed->n = csr.n;
+    reversed->m = csr.m;
+    reversed->present = csr.present;
+    reversed->out_offsets = csr.in_offsets;
+    reversed->out_targets = csr.in_sources;
+    reversed->out_weights = csr.in_weights;
+    reversed->in_offsets = csr.out_offsets;
+    reversed->in_sources = csr.out_targets;
+    reversed->in_weights = csr.out_weights;
+    place(*reversed);
+    return reversed;
+}
+
+std::shared_ptr<const CsrGraph> get_csr(Graph &graph) {
+    if (!graph.csr) graph.csr = build_csr(graph);
+    return graph.csr;
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef CSR_H_
+#define CSR_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Structures.h"
+
+/**
+ * @brief Read-only compressed sparse row copy of a graph.
+ *
+ * The adjacency lists of vertex v are stored contiguously in
+ * `out_targets[out_offsets[v] .. out_offsets[v + 1])` (and likewise for the
+ * inbound side), sorted by vertex, with the weight of every edge stored next
+ * to it. Traversals work on this copy so that they do not pay a hash lookup
+ * per vertex or per edge. Vertices are indexed by their internal ID; IDs that
+ * are not in use have empty lists and `present` set to 0.
+ */
+struct CsrGraph {
+    uint32_t n = 0;                      ///< One past the highest vertex ID.
+    uint64_t m = 0;                      ///< Number of edges.
+    std::vector<uint8_t> present;        ///< 1 for IDs in use.
+    std::vector<uint64_t> out_offsets;   ///< Start of each outbound list.
+    std::vector<uint32_t> out_targets;   ///< Children of each vertex.
+    std::vector<uint32_t> out_weights;   ///< Weights of the outbound edges.
+    std::vector<uint64_t> in_offsets;    ///< Start of each inbound list.
+    std::vector<uint32_t> in_sources;    ///< Parents of each vertex.
+    std::vector<uint32_t> in_weights;    ///< Weights of the inbound edges.
+};
+
+/**
+ * @brief Builds the CSR copy of a graph in parallel.
+ * @param graph The graph to copy.
+ * @return std::shared_ptr<const CsrGraph> The new copy.
+ */
+std::shared_ptr<const CsrGraph> build_csr(const Graph &graph);
+
+/**
+ * @brief Builds a CSR graph straight from a list of edges.
+ *
+ * @param n       Number of vertices, IDs must be below it.
+ * @param edges   The edges.
+ * @param weights Weight of every edge, empty for all weights 1.
+ * @return std::shared_ptr<const CsrGraph> The new graph.
+ */
+std::shared_ptr<const CsrGraph> build_csr(uint32_t n,
+                                          const std::vector<Edge> &edges,
+                                          const std::vector<uint32_t> &weights);
+
+/**
+ * @brief Builds the CSR graph with every edge reversed.
+ *
+ * Swaps the outbound and inbound sides, so searches towards a vertex can run
+ * as ordinary forward searches.
+ * @param csr The graph.
+ * @return std::shared_ptr<const CsrGraph> The reversed graph.
+ */
+std::shared_ptr<const CsrGraph> reverse_csr(const CsrGraph &csr);
+
+/**
+ * @brief Returns the CSR copy of a graph, building it if needed.
+ *
+ * The copy is cached in the graph until the next call to begin_mutation().
+ * @param graph The graph.
+ * @return std::shared_ptr<const CsrGraph> The copy.
+ */
+std::shared_ptr<const CsrGraph> get_csr(Graph &graph);
+
+#endif  // CSR_H_
@@ -26,10 +26,10 @@
 // program
 #include <sys/types.h>
 
-#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <ostream>
@@ -38,18 +38,31 @@
 #include <utility>
 #include <vector>
 
+#include "Adjacency.h"
+#include "Connectivity.h"
+#include "Data.h"
 #include "IdManager.h"
+#include "Metrics.h"
+#include "Reorder.h"
 #include "Structures.h"
 #define MAX_OPERATON_BUFFER 100
 
-void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
-               std::unordered_map<uint32_t, uint32_t *> &outbound,
-               std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                  pair_hash> &costs,
-               uint32_t &Vertices, uint32_t &Edges, char *filename,
+// Frees the linked lists read_data collects edges in
+static void free_nodes(std::vector<LinkedList *> &lists) {
+    for (LinkedList *node : lists) {
+        while (node != nullptr) {
+            LinkedList *next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+}
+
+void read_data(AdjacencyMap &inbound, AdjacencyMap &outbound, CostMap &costs,
+               uint32_t &Vertices, uint32_t &Edges, const char *filename,
                uint32_t vertex_buffer, IdManager &manager) {
-    auto start_time = std::chrono::high_resolution_clock::now();
-    std::ifstream input(filename);
+    OperationTimer timer(OPERATION_READ_DATA);
+    std::ifstream input(filename, std::ios::binary);
     if (!input.is_open()) {
         // Raise an error telling that the file was not opened
         // succesfully
@@ -58,18 +71,39 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
     }
     std::cout << "File opened\n";
 
-    uint32_t vertices = 0, edges;
-    input >> vertices >> edges;
+    uint32_t vertices = 0, edges = 0;
+    char magic[sizeof(GRAPH_BINARY_MAGIC)] = {0};
+    input.read(magic, sizeof(magic));
+    bool binary = input && std::memcmp(magic, GRAPH_BINARY_MAGIC,
+                                       sizeof(magic)) == 0;
+    if (binary) {
+        uint64_t count = 0;
+        input.read(reinterpret_cast<char *>(&vertices), sizeof(vertices));
+        input.read(reinterpret_cast<char *>(&count), sizeof(count));
+        if (!input) {
+            std::cerr << "File " << filename << " is truncated\n";
+            return;
+        }
+        if (count > UINT32_MAX) {
+            std::cerr << "The file has more edges than can be loaded\n";
+            return;
+        }
+        edges = static_cast<uint32_t>(count);
+    } else {
+        input.clear();
+        input.seekg(0);
+        input >> vertices >> edges;
+    }
     if (vertices == 0) {
         // Raise an error telling that the file is empty
         std::cerr << "The file is empty\n";
         return;
     }
 
-    uint16_t in_size[vertices] = {0};
-    uint16_t out_size[vertices] = {0};
-    // I don't expect very large out degrees so
-    // a 16 bit representation should suffice
+    // kept on the heap: the reader may run on a worker thread whose stack
+    // is much smaller than the main one
+    std::vector<uint32_t> in_size(vertices, 0);
+    std::vector<uint32_t> out_size(vertices, 0);
 
     std::vector<LinkedList *> outbound_Ll(vertices, nullptr);
     std::vector<LinkedList *> inbound_Ll(vertices, nullptr);
@@ -81,7 +115,25 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
     LinkedList *outboundNode;
     LinkedList *inboundNode;
     for (uint32_t i = 0; i < edges; i++) {
-        input >> iparent >> ichild >> cost;
+        if (binary) {
+            uint32_t record[3] = {0, 0, 0};
+            input.read(reinterpret_cast<char *>(record), sizeof(record));
+            iparent = record[0];
+            ichild = record[1];
+            cost = record[2];
+        } else {
+            input >> iparent >> ichild >> cost;
+        }
+        if (!input) {
+            std::cerr << "File " << filename << " is truncated: read " << i
+                      << " of " << edges << " edges\n";
+            free_nodes(outbound_Ll);
+            free_nodes(inbound_Ll);
+            costs.clear();
+            manager.map.clear();
+            manager.max_vertex = 0;
+            return;
+        }
         // increase the out and in size
         parent = get_id(manager, iparent);
         child = get_id(manager, ichild);
@@ -107,15 +159,14 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
     // store in the first cell the size of the occupied array
     // store in the cell after the remaining cells of the array
     for (uint32_t i = 0; i < vertices; i++) {
-        uint32_t *out = reinterpret_cast<uint32_t *>(
-            malloc(sizeof(uint32_t) * (out_size[i] + 1 + vertex_buffer)));
+        uint32_t *out = alloc_list(out_size[i] + 1 + vertex_buffer);
 
         LinkedList *node, *next;
         node = outbound_Ll[i];
         out[0] = out_size[i];
         // check if the list is not empty <good practice>
         if (node != nullptr) {
-            for (int j = 0; j < out_size[i]; j++) {
+            for (uint32_t j = 0; j < out_size[i]; j++) {
                 out[j + 1] =
                     node->value;    // Store the value of the current node
                 next = node->next;  // Get the next node
@@ -129,15 +180,14 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
 
     // create arrays for inbound edges
     for (uint32_t i = 0; i < vertices; i++) {
-        uint32_t *in = reinterpret_cast<uint32_t *>(
-            malloc(sizeof(uint32_t) * (in_size[i] + 1 + vertex_buffer)));
+        uint32_t *in = alloc_list(in_size[i] + 1 + vertex_buffer);
 
         LinkedList *node, *next;
         node = inbound_Ll[i];
         in[0] = in_size[i];
         // check if the list is not empty <good practice>
         if (node != nullptr) {
-            for (int j = 0; j < in_size[i]; j++) {
+            for (uint32_t j = 0; j < in_size[i]; j++) {
                 in[j + 1] = node->value;  // Store the value of the current node
                 next = node->next;        // Get the next node
                 delete node;              // Free the memory of the current node
@@ -152,10 +202,8 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
     for (uint32_t i = manager.map.size(); i < vertices; i++) {
         uint32_t new_vertex = generate_id(manager);
 
-        uint32_t *out = reinterpret_cast<uint32_t *>(
-            malloc(sizeof(uint32_t) * (vertex_buffer + 1)));
-        uint32_t *in = reinterpret_cast<uint32_t *>(
-            malloc(sizeof(uint32_t) * (vertex_buffer + 1)));
+        uint32_t *out = alloc_list(vertex_buffer + 1);
+        uint32_t *in = alloc_list(vertex_buffer + 1);
 
         out[vertex_buffer] = vertex_buffer;
         in[vertex_buffer] = vertex_buffer;
@@ -168,19 +216,14 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
 
     Vertices = vertices;
     Edges = edges;
+    timer.items = edges;
     input.close();
     std::cout << "reading finished\n";
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-        end_time - start_time);
-
-    std::cout << "Read took " << duration.count()
-              << " milliseconds to perform.\n";
 }
 
-void write_data(std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                   pair_hash> &costs,
-                uint32_t Vertices, uint32_t Edges, std::string filename) {
+void write_data(CostMap &costs, uint32_t Vertices, uint32_t Edges,
+                std::string filename, const IdTranslation *ids) {
+    OperationTimer timer(OPERATION_WRITE_DATA);
     std::ofstream output(filename);
 
     if (!output.is_open()) {
@@ -194,13 +237,14 @@ void write_data(std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
     auto it = costs.begin();
     while (it != costs.end()) {
         uint32_t parent, child, weight;
-        parent = it->first.first;
-        child = it->first.second;
+        parent = client_id(ids, it->first.first);
+        child = client_id(ids, it->first.second);
         weight = it->second;
 
         output << parent << " " << child << " " << weight << "\n";
         it++;
     }
+    timer.items = costs.size();
     output.close();
     std::cout << "Write finished\n";
 }
@@ -214,16 +258,25 @@ uint32_t s2i(std::string s) {
     }
 }
 
-uint8_t is_inside_array(uint32_t *arr, uint32_t value, uint16_t size,
-                        uint32_t start = 1) {
-    for (uint16_t i = start; i <= size; i++) {
+double s2d(std::string s) {
+    try {
+        return std::stod(s);
+    } catch (std::exception &e) {
+        std::cout << "input was not a number\n";
+        return -1;
+    }
+}
+
+uint8_t is_inside_array(uint32_t *arr, uint32_t value, uint32_t size,
+                        uint32_t start) {
+    for (uint32_t i = start; i <= size; i++) {
         if (arr[i] == value) return 1;
     }
     return 0;
 }
 
-uint8_t *check_edges(Edge *edges,
-                     std::unordered_map<uint32_t, uint32_t *> &outbound) {
+uint8_t *check_edges(Edge *edges, AdjacencyMap &outbound) {
+    OperationTimer timer(OPERATION_CHECK_EDGES);
     uint8_t *result = new uint8_t[MAX_OPERATON_BUFFER + 1]{0}, sz = 0;
 
     uint16_t i = 1;
@@ -232,18 +285,19 @@ uint8_t *check_edges(Edge *edges,
         if (i == MAX_OPERATON_BUFFER ||
             parent == NULL_EDGE.parent && child == NULL_EDGE.child) {
             result[0] = sz;
+            timer.items = sz;
             return result;
         }
-        result[i] =
-            (outbound.find(parent) != outbound.end() &&
-             is_inside_array(outbound[parent], child, outbound[parent][0]));
+        auto list = outbound.find(parent);
+        result[i] = (list != outbound.end() &&
+                     is_inside_array(list->second, child, list->second[0]));
         sz++;
         i++;
     }
 }
 
-uint32_t *get_degree(std::unordered_map<uint32_t, uint32_t *> &map,
-                     uint32_t *list_of_vertices) {
+uint32_t *get_degree(AdjacencyMap &map, uint32_t *list_of_vertices) {
+    OperationTimer timer(OPERATION_GET_DEGREE);
     uint32_t *result = new uint32_t[MAX_OPERATON_BUFFER + 1]{0};
     uint16_t i = 0;
     while (i < MAX_OPERATON_BUFFER) {
@@ -253,20 +307,22 @@ uint32_t *get_degree(std::unordered_map<uint32_t, uint32_t *> &map,
             i = MAX_OPERATON_BUFFER;
             continue;
         }
-        if (map.find(current_vertex) == map.end()) {
+        auto list = map.find(current_vertex);
+        if (list == map.end()) {
             i++;
             continue;
         }
-        uint16_t deg = map[current_vertex][0];
+        uint16_t deg = list->second[0];
         result[i + 1] = deg;
         i++;
     }
+    timer.items = result[0];
     return result;
 }
 
-vertex_map *get_vertices_connections(
-    std::unordered_map<uint32_t, uint32_t *> &map, uint32_t *list_of_vertices) {
-    auto start_time1 = std::chrono::high_resolution_clock::now();
+vertex_map *get_vertices_connections(AdjacencyMap &map,
+                                     uint32_t *list_of_vertices) {
+    OperationTimer timer(OPERATION_GET_CONNECTIONS);
     vertex_map *result = reinterpret_cast<vertex_map *>(
         malloc(sizeof(vertex_map) * MAX_OPERATON_BUFFER + 1));
     uint16_t i = 0;
@@ -274,28 +330,23 @@ vertex_map *get_vertices_connections(
         uint32_t current_vertex = list_of_vertices[i];
         if (current_vertex == UINT32_MAX) {
             result[0] = vertex_map(i, nullptr);
+            timer.items = i;
             i = MAX_OPERATON_BUFFER;
         }
-        if (map.find(current_vertex) == map.end()) {
+        auto list = map.find(current_vertex);
+        if (list == map.end()) {
             i++;
             continue;
         }
-        result[i + 1] = vertex_map(current_vertex, map[current_vertex]);
+        result[i + 1] = vertex_map(current_vertex, list->second);
         i++;
     }
-    auto end_time1 = std::chrono::high_resolution_clock::now();
-    auto duration1 = std::chrono::duration_cast<std::chrono::milliseconds>(
-        end_time1 - start_time1);
-
-    std::cout << "IIProcess took " << duration1.count()
-              << " milliseconds to perform.\n";
     return result;
 }
 
-uint16_t *get_weights_of_edges(
-    Edge *edges, std::unordered_map<uint32_t, uint32_t *> &outbound,
-    std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-        &costs) {
+uint16_t *get_weights_of_edges(Edge *edges, AdjacencyMap &outbound,
+                               CostMap &costs) {
+    OperationTimer timer(OPERATION_GET_WEIGHTS);
     uint16_t *result = new uint16_t[MAX_OPERATON_BUFFER + 1]{0}, sz = 0;
 
     uint16_t i = 1;
@@ -305,27 +356,28 @@ uint16_t *get_weights_of_edges(
         if (i == MAX_OPERATON_BUFFER ||
             (parent == NULL_EDGE.parent && child == NULL_EDGE.child)) {
             result[0] = sz;
+            timer.items = sz;
             return result;
         }
-        if (costs.find(std::make_pair(parent, child)) == costs.end()) {
+        auto cost = costs.find(std::make_pair(parent, child));
+        if (cost == costs.end()) {
             i++;
             continue;
         }
-        result[i] = costs[std::make_pair(parent, child)];
+        result[i] = cost->second;
         sz++;
         i++;
     }
     return result;
 }
 void change_weights_of_edges(Edge *edges, uint32_t *weights,
-                             std::unordered_map<uint32_t, uint32_t *> &outbound,
-                             std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                                uint32_t, pair_hash> &costs) {
+                             AdjacencyMap &outbound, CostMap &costs) {
+    OperationTimer timer(OPERATION_CHANGE_WEIGHTS);
     uint16_t i = 0;
 
     while (i < MAX_OPERATON_BUFFER) {
         uint32_t parent = edges[i].parent, child = edges[i].child;
-        if (parent == NULL_EDGE.parent && child == NULL_EDGE.child) return;
+        if (parent == NULL_EDGE.parent && child == NULL_EDGE.child) break;
         if (costs.find(std::make_pair(parent, child)) == costs.end()) {
             i++;
             continue;
@@ -333,13 +385,15 @@ void change_weights_of_edges(Edge *edges, uint32_t *weights,
         costs[std::make_pair(parent, child)] = weights[i];
         i++;
     }
+    timer.items = i;
     return;
 }
 
 uint32_t *add_vertices(uint32_t number_of_vertices, IdManager &manager,
-                       uint16_t vertex_buffer,
-                       std::unordered_map<uint32_t, uint32_t *> &outbound,
-                       std::unordered_map<uint32_t, uint32_t *> &inbound) {
+                       uint16_t vertex_buffer, AdjacencyMap &outbound,
+                       AdjacencyMap &inbound, ConnectivityIndex *connectivity) {
+    OperationTimer timer(OPERATION_ADD_VERTICES);
+    timer.items = number_of_vertices;
     uint32_t *result = reinterpret_cast<uint32_t *>(
         malloc(sizeof(uint32_t) * (number_of_vertices + 1)));
     result[0] = number_of_vertices;  // Store the count of added vertices
@@ -348,10 +402,8 @@ uint32_t *add_vertices(uint32_t number_of_vertices, IdManager &manager,
         uint32_t new_vertex = generate_id(manager);
         result[i + 1] = new_vertex;
 
-        uint32_t *out = reinterpret_cast<uint32_t *>(
-            malloc(sizeof(uint32_t) * (vertex_buffer + 1)));
-        uint32_t *in = reinterpret_cast<uint32_t *>(
-            malloc(sizeof(uint32_t) * (vertex_buffer + 1)));
+        uint32_t *out = alloc_list(vertex_buffer + 1);
+        uint32_t *in = alloc_list(vertex_buffer + 1);
 
         out[0] = 0;  // No outbound edges initially
         out[vertex_buffer] = vertex_buffer;
@@ -360,30 +412,38 @@ uint32_t *add_vertices(uint32_t number_of_vertices, IdManager &manager,
 
         outbound[new_vertex] = out;
         inbound[new_vertex] = in;
+        if (connectivity) connectivity_add_vertex(*connectivity, new_vertex);
     }
     return result;
 }
 
 uint32_t *remove_vertices(uint32_t *list_of_vertices, IdManager &manager,
-                          std::unordered_map<uint32_t, uint32_t *> &outbound,
-                          std::unordered_map<uint32_t, uint32_t *> &inbound,
-                          std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                             uint32_t, pair_hash> &costs) {
+                          AdjacencyMap &outbound, AdjacencyMap &inbound,
+                          CostMap &costs, ConnectivityIndex *connectivity) {
+    OperationTimer timer(OPERATION_REMOVE_VERTICES);
     uint32_t *result = reinterpret_cast<uint32_t *>(
         malloc(sizeof(uint32_t) * (MAX_OPERATON_BUFFER + 1)));
     result[0] = 0;  // Store the count of removed vertices
+    std::vector<uint32_t> neighbors;
 
     for (uint32_t i = 0; i < MAX_OPERATON_BUFFER; i++) {
         uint32_t vertex = list_of_vertices[i];
         if (vertex == UINT32_MAX) break;
+        timer.items++;
 
         if (outbound.find(vertex) == outbound.end()) continue;
 
         uint32_t *out_list = outbound[vertex];
+        if (connectivity) {
+            uint32_t *in_list = inbound[vertex];
+            neighbors.assign(out_list + 1, out_list + 1 + out_list[0]);
+            neighbors.insert(neighbors.end(), in_list + 1,
+                             in_list + 1 + in_list[0]);
+        }
         for (uint32_t j = 1; j <= out_list[0]; j++) {
             uint32_t child = out_list[j];
 
-            uint32_t *in_list = inbound[child];
+            uint32_t *in_list = writable_list(inbound[child]);
             for (uint32_t k = 1; k <= in_list[0]; k++) {
                 if (in_list[k] == vertex) {
                     in_list[k] = in_list[in_list[0]--];
@@ -393,14 +453,14 @@ uint32_t *remove_vertices(uint32_t *list_of_vertices, IdManager &manager,
 
             costs.erase({vertex, child});
         }
-        free(out_list);
+        release_list(out_list);
         outbound.erase(vertex);
 
         uint32_t *in_list = inbound[vertex];
         for (uint32_t j = 1; j <= in_list[0]; j++) {
             uint32_t parent = in_list[j];
 
-            uint32_t *out_list = outbound[parent];
+            uint32_t *out_list = writable_list(outbound[parent]);
             for (uint32_t k = 1; k <= out_list[0]; k++) {
                 if (out_list[k] == vertex) {
                     out_list[k] = out_list[out_list[0]--];
@@ -409,20 +469,22 @@ uint32_t *remove_vertices(uint32_t *list_of_vertices, IdManager &manager,
             }
             costs.erase({parent, vertex});
         }
-        free(in_list);
+        release_list(in_list);
         inbound.erase(vertex);
         remove_id(manager, vertex);
+        if (connectivity)
+            connectivity_remove_vertex(*connectivity, outbound, inbound,
+                                       vertex, neighbors);
         result[++result[0]] = vertex;
     }
     return result;
 }
 
 uint32_t *add_edges(Edge *list_of_edges, uint32_t *weights,
-                    uint16_t vertex_buffer,
-                    std::unordered_map<uint32_t, uint32_t *> &outbound,
-                    std::unordered_map<uint32_t, uint32_t *> &inbound,
-                    std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                       pair_hash> &costs) {
+                    uint16_t vertex_buffer, AdjacencyMap &outbound,
+                    AdjacencyMap &inbound, CostMap &costs,
+                    ConnectivityIndex *connectivity) {
+    OperationTimer timer(OPERATION_ADD_EDGES);
     uint32_t *result = new uint32_t[MAX_OPERATON_BUFFER + 1]{0};
     result[0] = 0;  // Number of successfully added edges
 
@@ -439,26 +501,33 @@ uint32_t *add_edges(Edge *list_of_edges, uint32_t *weights,
         }
 
         uint32_t *out_list = outbound[parent];
-        uint32_t *in_list = inbound[child];
 
         if (!is_inside_array(out_list, child, out_list[0])) {
+            // copies the lists if a fork shares them, and grows them once
+            // their buffer is used up
+            out_list = writable_list(outbound[parent], out_list[0] + 2);
+            uint32_t *in_list =
+                writable_list(inbound[child], inbound[child][0] + 2);
             out_list[out_list[0] + 1] = child;
             out_list[0]++;
             in_list[in_list[0] + 1] = parent;
             in_list[0]++;
             result[++result[0]] = i;  // Store the index of the added edge
             costs[std::make_pair(parent, child)] = weights[i];
+            if (connectivity)
+                connectivity_add_edge(*connectivity, outbound, inbound, parent,
+                                      child);
         }
         i++;
     }
+    timer.items = i;
     return result;
 }
 
 uint32_t *remove_edges(Edge *list_of_edges, uint16_t vertex_buffer,
-                       std::unordered_map<uint32_t, uint32_t *> &outbound,
-                       std::unordered_map<uint32_t, uint32_t *> &inbound,
-                       std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                          uint32_t, pair_hash> &costs) {
+                       AdjacencyMap &outbound, AdjacencyMap &inbound,
+                       CostMap &costs, ConnectivityIndex *connectivity) {
+    OperationTimer timer(OPERATION_REMOVE_EDGES);
     uint32_t *result = new uint32_t[MAX_OPERATON_BUFFER + 1]{0};
     result[0] = 0;  // Number of successfully removed edges
 
@@ -475,10 +544,11 @@ uint32_t *remove_edges(Edge *list_of_edges, uint16_t vertex_buffer,
         }
 
         uint32_t *out_list = outbound[parent];
-        uint32_t *in_list = inbound[child];
 
         for (uint32_t j = 1; j <= out_list[0]; j++) {
             if (out_list[j] == child) {
+                out_list = writable_list(outbound[parent]);
+                uint32_t *in_list = writable_list(inbound[child]);
                 out_list[j] = out_list[out_list[0]--];
                 for (uint32_t k = 1; k <= in_list[0]; k++) {
                     if (in_list[k] == parent) {
@@ -488,11 +558,15 @@ uint32_t *remove_edges(Edge *list_of_edges, uint16_t vertex_buffer,
                         break;
                     }
                 }
+                if (connectivity)
+                    connectivity_remove_edge(*connectivity, outbound, inbound,
+                                             parent, child);
                 break;
             }
         }
         costs.erase(std::make_pair(parent, child));
         i++;
     }
+    timer.items = i;
     return result;
 }
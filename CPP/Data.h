@@ -16,10 +16,19 @@
 
 #define MAX_OPERATON_BUFFER 100
 
+/// First bytes of a graph file in the binary format, see read_data().
+const char GRAPH_BINARY_MAGIC[4] = {'G', 'R', 'B', '1'};
+
 /**
  * @brief Reads graph data from a file and stores it in adjacency lists and cost
  * mappings.
  *
+ * Text files hold the numbers of vertices and edges, then one "parent child
+ * weight" line per edge. Binary files start with GRAPH_BINARY_MAGIC, the
+ * number of vertices as a uint32_t and of edges as a uint64_t, then hold
+ * every edge as three uint32_t (parent, child, weight) in the machine's
+ * byte order.
+ *
  * @param inbound      Reference to the inbound adjacency list map.
  * @param outbound     Reference to the outbound adjacency list map.
  * @param costs        Reference to the cost map for edges.
@@ -29,11 +38,8 @@
  * @param vertex_buffer Buffer size for vertex storage.
  * @param manager      Reference to the ID manager.
  */
-void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
-               std::unordered_map<uint32_t, uint32_t *> &outbound,
-               std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                  pair_hash> &costs,
-               uint32_t &Vertices, uint32_t &Edges, char *filename,
+void read_data(AdjacencyMap &inbound, AdjacencyMap &outbound, CostMap &costs,
+               uint32_t &Vertices, uint32_t &Edges, const char *filename,
                uint32_t vertex_buffer, IdManager &manager);
 
 /**
@@ -43,10 +49,11 @@ void read_data(std::unordered_map<uint32_t, uint32_t *> &inbound,
  * @param Vertices Number of vertices in the graph.
  * @param Edges    Number of edges in the graph.
  * @param filename Name of the file to write to.
+ * @param ids      If not null, vertices are written with the client IDs it
+ * gives them.
  */
-void write_data(std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                   pair_hash> &costs,
-                uint32_t Vertices, uint32_t Edges, std::string filename);
+void write_data(CostMap &costs, uint32_t Vertices, uint32_t Edges,
+                std::string filename, const IdTranslation *ids = nullptr);
 
 /**
  * @brief Converts a string to an unsigned 32-bit integer.
@@ -56,6 +63,14 @@ void write_data(std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
  */
 uint32_t s2i(std::string s);
 
+/**
+ * @brief Converts a string to a floating point number.
+ *
+ * @param s The input string.
+ * @return double The converted number or -1 on failure.
+ */
+double s2d(std::string s);
+
 /**
  * @brief Checks if a value exists within an array.
  *
@@ -65,7 +80,7 @@ uint32_t s2i(std::string s);
  * @param start The starting index for searching (default is 1).
  * @return uint8_t Returns 1 if found, 0 otherwise.
  */
-uint8_t is_inside_array(uint32_t *arr, uint32_t value, uint16_t size,
+uint8_t is_inside_array(uint32_t *arr, uint32_t value, uint32_t size,
                         uint32_t start = 1);
 
 /**
@@ -75,8 +90,7 @@ uint8_t is_inside_array(uint32_t *arr, uint32_t value, uint16_t size,
  * @param outbound Reference to the outbound adjacency list.
  * @return uint8_t* Dynamically allocated array indicating edge existence.
  */
-uint8_t *check_edges(Edge *edges,
-                     std::unordered_map<uint32_t, uint32_t *> &outbound);
+uint8_t *check_edges(Edge *edges, AdjacencyMap &outbound);
 
 /**
  * @brief Retrieves the degree of a set of vertices.
@@ -85,8 +99,7 @@ uint8_t *check_edges(Edge *edges,
  * @param list_of_vertices Pointer to the list of vertices.
  * @return uint32_t* Dynamically allocated array containing vertex degrees.
  */
-uint32_t *get_degree(std::unordered_map<uint32_t, uint32_t *> &map,
-                     uint32_t *list_of_vertices);
+uint32_t *get_degree(AdjacencyMap &map, uint32_t *list_of_vertices);
 
 /**
  * @brief Retrieves adjacency lists for a set of vertices.
@@ -96,8 +109,8 @@ uint32_t *get_degree(std::unordered_map<uint32_t, uint32_t *> &map,
  * @return vertex_map* Dynamically allocated structure containing adjacency
  * lists.
  */
-vertex_map *get_vertices_connections(
-    std::unordered_map<uint32_t, uint32_t *> &map, uint32_t *list_of_vertices);
+vertex_map *get_vertices_connections(AdjacencyMap &map,
+                                     uint32_t *list_of_vertices);
 
 /**
  * @brief Retrieves weights for a list of edges.
@@ -107,10 +120,8 @@ vertex_map *get_vertices_connections(
  * @param costs    Reference to the edge cost map.
  * @return uint16_t* Dynamically allocated array containing edge weights.
  */
-uint16_t *get_weights_of_edges(
-    Edge *edges, std::unordered_map<uint32_t, uint32_t *> &outbound,
-    std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-        &costs);
+uint16_t *get_weights_of_edges(Edge *edges, AdjacencyMap &outbound,
+                               CostMap &costs);
 
 /**
  * @brief Modifies weights for a list of edges.
@@ -121,9 +132,7 @@ uint16_t *get_weights_of_edges(
  * @param costs    Reference to the edge cost map.
  */
 void change_weights_of_edges(Edge *edges, uint32_t *weights,
-                             std::unordered_map<uint32_t, uint32_t *> &outbound,
-                             std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                                uint32_t, pair_hash> &costs);
+                             AdjacencyMap &outbound, CostMap &costs);
 
 /**
  * @brief Adds a set of vertices to the graph.
@@ -133,12 +142,13 @@ void change_weights_of_edges(Edge *edges, uint32_t *weights,
  * @param vertex_buffer      Buffer size for vertex storage.
  * @param outbound           Reference to the outbound adjacency list.
  * @param inbound            Reference to the inbound adjacency list.
+ * @param connectivity       Connectivity index to update, may be null.
  * @return uint32_t* Pointer to newly added vertices.
  */
 uint32_t *add_vertices(uint32_t number_of_vertices, IdManager &manager,
-                       uint16_t vertex_buffer,
-                       std::unordered_map<uint32_t, uint32_t *> &outbound,
-                       std::unordered_map<uint32_t, uint32_t *> &inbound);
+                       uint16_t vertex_buffer, AdjacencyMap &outbound,
+                       AdjacencyMap &inbound,
+                       ConnectivityIndex *connectivity = nullptr);
 
 /**
  * @brief Removes a set of vertices from the graph.
@@ -148,13 +158,13 @@ uint32_t *add_vertices(uint32_t number_of_vertices, IdManager &manager,
  * @param outbound         Reference to the outbound adjacency list.
  * @param inbound          Reference to the inbound adjacency list.
  * @param costs            Reference to the edge cost map.
+ * @param connectivity     Connectivity index to update, may be null.
  * @return uint32_t* Pointer to removed vertices.
  */
 uint32_t *remove_vertices(uint32_t *list_of_vertices, IdManager &manager,
-                          std::unordered_map<uint32_t, uint32_t *> &outbound,
-                          std::unordered_map<uint32_t, uint32_t *> &inbound,
-                          std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                             uint32_t, pair_hash> &costs);
+                          AdjacencyMap &outbound, AdjacencyMap &inbound,
+                          CostMap &costs,
+                          ConnectivityIndex *connectivity = nullptr);
 
 /**
  * @brief Adds a set of edges to the graph.
@@ -165,14 +175,13 @@ uint32_t *remove_vertices(uint32_t *list_of_vertices, IdManager &manager,
  * @param outbound      Reference to the outbound adjacency list.
  * @param inbound       Reference to the inbound adjacency list.
  * @param costs         Reference to the edge cost map.
+ * @param connectivity  Connectivity index to update, may be null.
  * @return uint32_t* Pointer to added edges.
  */
 uint32_t *add_edges(Edge *list_of_edges, uint32_t *weights,
-                    uint16_t vertex_buffer,
-                    std::unordered_map<uint32_t, uint32_t *> &outbound,
-                    std::unordered_map<uint32_t, uint32_t *> &inbound,
-                    std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                       pair_hash> &costs);
+                    uint16_t vertex_buffer, AdjacencyMap &outbound,
+                    AdjacencyMap &inbound, CostMap &costs,
+                    ConnectivityIndex *connectivity = nullptr);
 
 /**
  * @brief Removes a set of edges from the graph.
@@ -182,13 +191,13 @@ uint32_t *add_edges(Edge *list_of_edges, uint32_t *weights,
  * @param outbound      Reference to the outbound adjacency list.
  * @param inbound       Reference to the inbound adjacency list.
  * @param costs         Reference to the edge cost map.
+ * @param connectivity  Connectivity index to update, may be null.
  * @return uint32_t* Pointer to removed edges.
  */
 uint32_t *remove_edges(Edge *list_of_edges, uint16_t vertex_buffer,
-                       std::unordered_map<uint32_t, uint32_t *> &outbound,
-                       std::unordered_map<uint32_t, uint32_t *> &inbound,
-                       std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                          uint32_t, pair_hash> &costs);
+                       AdjacencyMap &outbound, AdjacencyMap &inbound,
+                       CostMap &costs,
+                       ConnectivityIndex *connectivity = nullptr);
 
 #endif  // DATA_H_
 
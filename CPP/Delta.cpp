@@ -0,0 +1,266 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Adjacency.h"
+#include "Delta.h"
+#include "IdManager.h"
+#include "Metrics.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+struct DeltaEdge {
+    uint32_t parent;
+    uint32_t child;
+    uint32_t weight;
+};
+
+// One adjacency list to rewrite, together with the sorted vertices to drop
+// from it and the vertices to append to it
+struct MergeTask {
+    uint32_t **slot;
+    const uint32_t *removed;
+    uint32_t n_removed;
+    const uint32_t *added;
+    uint32_t n_added;
+    uint32_t dropped;  // entries actually removed, parallel copies included
+};
+
+static void merge_list(uint32_t *&slot, MergeTask &task,
+                       uint32_t vertex_buffer) {
+    uint32_t *list =
+        writable_list(slot, slot[0] + task.n_added + 1 + vertex_buffer);
+    uint32_t size = 0;
+    if (task.n_removed) {
+        for (uint32_t j = 1; j <= list[0]; j++) {
+            if (!std::binary_search(task.removed,
+                                    task.removed + task.n_removed, list[j]))
+                list[++size] = list[j];
+        }
+        task.dropped = list[0] - size;
+    } else {
+        size = list[0];
+    }
+
+    for (uint32_t j = 0; j < task.n_added; j++)
+        list[size + 1 + j] = task.added[j];
+    list[0] = size + task.n_added;
+}
+
+// Groups the edges, sorted by the vertex owning the list, into one task per
+// touched list
+static void group_tasks(AdjacencyMap &map,
+                        const std::vector<std::pair<uint32_t, uint32_t>> &rm,
+                        const std::vector<std::pair<uint32_t, uint32_t>> &add,
+                        const std::vector<uint32_t> &rm_values,
+                        const std::vector<uint32_t> &add_values,
+                        std::vector<MergeTask> &tasks) {
+    size_t i = 0, j = 0;
+    while (i < rm.size() || j < add.size()) {
+        uint32_t vertex;
+        if (j == add.size() || (i < rm.size() && rm[i].first < add[j].first))
+            vertex = rm[i].first;
+        else
+            vertex = add[j].first;
+
+        MergeTask task = {&map[vertex], rm_values.data() + i, 0,
+                          add_values.data() + j, 0, 0};
+        while (i < rm.size() && rm[i].first == vertex) {
+            task.n_removed++;
+            i++;
+        }
+        while (j < add.size() && add[j].first == vertex) {
+            task.n_added++;
+            j++;
+        }
+        tasks.push_back(task);
+    }
+}
+
+static void sorted_by(const std::vector<DeltaEdge> &edges, bool by_parent,
+                      std::vector<std::pair<uint32_t, uint32_t>> &keys,
+                      std::vector<uint32_t> &values) {
+    keys.clear();
+    keys.reserve(edges.size());
+    for (const DeltaEdge &e : edges) {
+        if (by_parent)
+            keys.emplace_back(e.parent, e.child);
+        else
+            keys.emplace_back(e.child, e.parent);
+    }
+    std::sort(keys.begin(), keys.end());
+    values.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) values[i] = keys[i].second;
+}
+
+int apply_delta(Graph &graph, const char *filename, uint32_t vertex_buffer) {
+    OperationTimer timer(OPERATION_APPLY_DELTA);
+    std::ifstream input(filename);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open file " << filename << std::endl;
+        return 0;
+    }
+
+    // read everything with the file's IDs first, so that a malformed file
+    // does not leave half-registered vertices behind
+    std::vector<DeltaEdge> adds, removes, weights;
+    std::string section;
+    uint32_t count;
+    while (input >> section >> count) {
+        std::vector<DeltaEdge> *target;
+        if (section == "add")
+            target = &adds;
+        else if (section == "remove")
+            target = &removes;
+        else if (section == "weight")
+            target = &weights;
+        else {
+            std::cerr << "Unknown delta section " << section << "\n";
+            return 0;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            DeltaEdge e = {0, 0, 0};
+            input >> e.parent >> e.child;
+            if (target != &removes) input >> e.weight;
+            if (!input) {
+                std::cerr << "Delta section " << section << " is truncated\n";
+                return 0;
+            }
+            target->push_back(e);
+        }
+    }
+    input.close();
+    timer.items = adds.size() + removes.size() + weights.size();
+
+    // translate to internal IDs, creating the vertices new edges point to
+    IdManager &manager = *graph.manager;
+    auto known = [&manager](DeltaEdge &e) {
+        auto p = manager.map.find(e.parent), c = manager.map.find(e.child);
+        if (p == manager.map.end() || c == manager.map.end()) return false;
+        e.parent = p->second;
+        e.child = c->second;
+        return true;
+    };
+    removes.erase(std::remove_if(removes.begin(), removes.end(),
+                                 [&known](DeltaEdge &e) { return !known(e); }),
+                  removes.end());
+    for (DeltaEdge &e : adds) {
+        e.parent = get_id(manager, e.parent);
+        e.child = get_id(manager, e.child);
+        for (uint32_t v : {e.parent, e.child}) {
+            if (graph.outbound->count(v)) continue;
+            uint32_t *out = alloc_list(vertex_buffer + 1);
+            uint32_t *in = alloc_list(vertex_buffer + 1);
+            out[0] = 0;
+            out[vertex_buffer] = vertex_buffer;
+            in[0] = 0;
+            in[vertex_buffer] = vertex_buffer;
+            (*graph.outbound)[v] = out;
+            (*graph.inbound)[v] = in;
+            graph.vertices++;
+        }
+    }
+    // weights may name vertices the adds above just created
+    weights.erase(std::remove_if(weights.begin(), weights.end(),
+                                 [&known](DeltaEdge &e) { return !known(e); }),
+                  weights.end());
+
+    // update the cost map, keeping only the changes that actually apply
+    auto by_edge = [](const DeltaEdge &a, const DeltaEdge &b) {
+        return a.parent < b.parent ||
+               (a.parent == b.parent && a.child < b.child);
+    };
+    auto same_edge = [](const DeltaEdge &a, const DeltaEdge &b) {
+        return a.parent == b.parent && a.child == b.child;
+    };
+    std::sort(removes.begin(), removes.end(), by_edge);
+    removes.erase(std::unique(removes.begin(), removes.end(), same_edge),
+                  removes.end());
+    std::stable_sort(adds.begin(), adds.end(), by_edge);
+    adds.erase(std::unique(adds.begin(), adds.end(), same_edge), adds.end());
+
+    auto &costs = *graph.costs;
+    size_t kept = 0;
+    for (const DeltaEdge &e : removes) {
+        if (costs.erase({e.parent, e.child})) removes[kept++] = e;
+    }
+    removes.resize(kept);
+    kept = 0;
+    for (const DeltaEdge &e : adds) {
+        if (costs.emplace(std::make_pair(e.parent, e.child), e.weight).second)
+            adds[kept++] = e;
+    }
+    adds.resize(kept);
+    uint32_t changed = 0;
+    for (const DeltaEdge &e : weights) {
+        if (!costs.count({e.parent, e.child})) continue;
+        costs[{e.parent, e.child}] = e.weight;
+        changed++;
+    }
+
+    // merge into the adjacency lists, one task per touched list
+    std::vector<std::pair<uint32_t, uint32_t>> out_rm, out_add, in_rm, in_add;
+    std::vector<uint32_t> out_rm_v, out_add_v, in_rm_v, in_add_v;
+    sorted_by(removes, true, out_rm, out_rm_v);
+    sorted_by(adds, true, out_add, out_add_v);
+    sorted_by(removes, false, in_rm, in_rm_v);
+    sorted_by(adds, false, in_add, in_add_v);
+
+    std::vector<MergeTask> tasks;
+    group_tasks(*graph.outbound, out_rm, out_add, out_rm_v, out_add_v, tasks);
+    size_t out_tasks = tasks.size();
+    group_tasks(*graph.inbound, in_rm, in_add, in_rm_v, in_add_v, tasks);
+
+    parallel_for(
+        0, tasks.size(),
+        [&tasks, vertex_buffer](size_t from, size_t to) {
+            for (size_t t = from; t < to; t++) {
+                merge_list(*tasks[t].slot, tasks[t], vertex_buffer);
+            }
+        },
+        64);
+
+    // a removed pair drops every parallel copy from the lists, so count
+    // the outbound entries that actually went away
+    uint32_t dropped = 0;
+    for (size_t t = 0; t < out_tasks; t++) dropped += tasks[t].dropped;
+    graph.edges += adds.size();
+    graph.edges -= dropped;
+    // the lists were rewritten in bulk; the connectivity index is rebuilt
+    // on its next use
+    graph.connectivity.reset();
+
+    std::cout << "Added " << adds.size() << " edges, removed "
+              << dropped << " edges, changed " << changed
+              << " weights\n";
+    return 1;
+}
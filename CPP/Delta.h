@@ -0,0 +1,59 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef DELTA_H_
+#define DELTA_H_
+
+#include <cstdint>
+
+#include "Structures.h"
+
+/**
+ * @brief Applies a delta file to a loaded graph.
+ *
+ * A delta file is made of sections, each starting with a header naming the
+ * section and the number of lines that follow it:
+ *
+ *     add <count>       followed by `<parent> <child> <weight>` lines
+ *     remove <count>    followed by `<parent> <child>` lines
+ *     weight <count>    followed by `<parent> <child> <weight>` lines
+ *
+ * Vertices are given with the same IDs as in the graph file and are mapped
+ * through the graph's ID manager; unknown vertices named by an addition are
+ * created. Removals are applied before additions and weight changes last.
+ * Adding an existing edge or removing a missing one is ignored.
+ *
+ * The delta is sorted by vertex and merged into the adjacency lists of the
+ * touched vertices in one parallel pass, so the cost is proportional to the
+ * size of the delta rather than the size of the graph.
+ *
+ * @param graph         The graph to update.
+ * @param filename      Name of the delta file.
+ * @param vertex_buffer Buffer size for vertex storage.
+ * @return int 1 if the delta was applied, 0 if the file could not be read.
+ * @note Call begin_mutation() on the graph first.
+ */
+int apply_delta(Graph &graph, const char *filename, uint32_t vertex_buffer);
+
+#endif  // DELTA_H_
@@ -0,0 +1,261 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Csr.h"
+#include "Flow.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+// Residual graph: the arcs of v are its outbound edges followed by the
+// reverses of its inbound edges
+struct Residual {
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> head;
+    std::vector<uint64_t> capacity;  // residual capacity
+    std::vector<uint64_t> reverse;   // index of the paired arc
+};
+
+static Residual build_residual(const CsrGraph &csr) {
+    uint32_t n = csr.n;
+    Residual r;
+    r.offsets.assign(n + 1, 0);
+    for (uint32_t v = 0; v < n; v++) {
+        r.offsets[v + 1] = r.offsets[v] +
+                           (csr.out_offsets[v + 1] - csr.out_offsets[v]) +
+                           (csr.in_offsets[v + 1] - csr.in_offsets[v]);
+    }
+    r.head.resize(r.offsets[n]);
+    r.capacity.resize(r.offsets[n]);
+    r.reverse.resize(r.offsets[n]);
+
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++) {
+            uint64_t out_begin = csr.out_offsets[v];
+            uint64_t out_degree = csr.out_offsets[v + 1] - out_begin;
+            for (uint64_t k = 0; k < out_degree; k++) {
+                uint32_t u = csr.out_targets[out_begin + k];
+                uint64_t a = r.offsets[v] + k;
+                r.head[a] = u;
+                r.capacity[a] = csr.out_weights[out_begin + k];
+                // lists are sorted, so v is found by bisection; the c-th
+                // parallel copy of v -> u pairs with the c-th copy of v in
+                // the inbound list of u
+                const uint32_t *out = &csr.out_targets[0] + out_begin;
+                uint64_t copy = k - (std::lower_bound(out, out + k, u) - out);
+                const uint32_t *first = &csr.in_sources[0] + csr.in_offsets[u];
+                const uint32_t *last =
+                    &csr.in_sources[0] + csr.in_offsets[u + 1];
+                uint64_t j = std::lower_bound(first, last, v) - first + copy;
+                uint64_t u_out = csr.out_offsets[u + 1] - csr.out_offsets[u];
+                r.reverse[a] = r.offsets[u] + u_out + j;
+            }
+            uint64_t in_begin = csr.in_offsets[v];
+            uint64_t in_degree = csr.in_offsets[v + 1] - in_begin;
+            for (uint64_t j = 0; j < in_degree; j++) {
+                uint32_t u = csr.in_sources[in_begin + j];
+                uint64_t a = r.offsets[v] + out_degree + j;
+                r.head[a] = u;
+                r.capacity[a] = 0;
+                const uint32_t *in = &csr.in_sources[0] + in_begin;
+                uint64_t copy = j - (std::lower_bound(in, in + j, u) - in);
+                const uint32_t *first = &csr.out_targets[0] +
+                                        csr.out_offsets[u];
+                const uint32_t *last =
+                    &csr.out_targets[0] + csr.out_offsets[u + 1];
+                r.reverse[a] = r.offsets[u] +
+                               (std::lower_bound(first, last, v) - first) +
+                               copy;
+            }
+        }
+    });
+    return r;
+}
+
+class PushRelabel {
+ public:
+    PushRelabel(Residual r, uint32_t n, uint32_t source, uint32_t sink)
+        : r_(std::move(r)), n_(n), source_(source), sink_(sink), label_(n, 0),
+          excess_(n, 0), current_(n), count_(n + 1, 0), queued_(n, 0) {}
+
+    uint64_t run() {
+        label_[source_] = n_;
+        for (uint64_t a = r_.offsets[source_]; a < r_.offsets[source_ + 1];
+             a++) {
+            uint64_t c = r_.capacity[a];
+            if (c == 0) continue;
+            r_.capacity[a] = 0;
+            r_.capacity[r_.reverse[a]] += c;
+            excess_[r_.head[a]] += c;
+        }
+        global_relabel();
+
+        while (!queue_.empty()) {
+            uint32_t v = queue_.front();
+            queue_.pop_front();
+            queued_[v] = 0;
+            discharge(v);
+            if (relabels_ >= n_) global_relabel();
+        }
+        return excess_[sink_];
+    }
+
+    // After run(): 1 for vertices that can still reach the sink
+    std::vector<uint8_t> sink_side() {
+        global_relabel();
+        std::vector<uint8_t> side(n_, 0);
+        for (uint32_t v = 0; v < n_; v++) side[v] = label_[v] < n_;
+        return side;
+    }
+
+ private:
+    Residual r_;
+    uint32_t n_, source_, sink_;
+    std::vector<uint32_t> label_;
+    std::vector<uint64_t> excess_;
+    std::vector<uint64_t> current_;  // next arc to try
+    std::vector<uint32_t> count_;    // vertices per label below n
+    std::vector<uint8_t> queued_;
+    std::deque<uint32_t> queue_;
+    uint32_t relabels_ = 0;
+
+    void enqueue(uint32_t v) {
+        if (queued_[v] || v == source_ || v == sink_ || excess_[v] == 0 ||
+            label_[v] >= n_)
+            return;
+        queued_[v] = 1;
+        queue_.push_back(v);
+    }
+
+    // Exact distances to the sink over residual arcs; vertices that cannot
+    // reach it are set to n
+    void global_relabel() {
+        relabels_ = 0;
+        std::fill(label_.begin(), label_.end(), n_);
+        std::fill(count_.begin(), count_.end(), 0);
+        std::vector<uint32_t> bfs(1, sink_);
+        label_[sink_] = 0;
+        for (size_t i = 0; i < bfs.size(); i++) {
+            uint32_t w = bfs[i];
+            count_[label_[w]]++;
+            for (uint64_t a = r_.offsets[w]; a < r_.offsets[w + 1]; a++) {
+                uint32_t x = r_.head[a];
+                if (label_[x] != n_ || x == source_ ||
+                    r_.capacity[r_.reverse[a]] == 0)
+                    continue;
+                label_[x] = label_[w] + 1;
+                bfs.push_back(x);
+            }
+        }
+        for (uint32_t v = 0; v < n_; v++) current_[v] = r_.offsets[v];
+
+        // the queue is rebuilt from the vertices that still matter
+        for (uint32_t v : queue_) queued_[v] = 0;
+        queue_.clear();
+        for (uint32_t x : bfs) enqueue(x);
+    }
+
+    void relabel(uint32_t v) {
+        relabels_++;
+        uint32_t old = label_[v];
+        uint32_t lowest = n_;
+        for (uint64_t a = r_.offsets[v]; a < r_.offsets[v + 1]; a++) {
+            if (r_.capacity[a] > 0)
+                lowest = std::min(lowest, label_[r_.head[a]] + 1);
+        }
+        count_[old]--;
+        label_[v] = std::min(lowest, n_);
+        if (label_[v] < n_) count_[label_[v]]++;
+        current_[v] = r_.offsets[v];
+
+        if (count_[old] == 0) {
+            // gap: nothing above `old` can reach the sink any more
+            for (uint32_t u = 0; u < n_; u++) {
+                if (label_[u] > old && label_[u] < n_) {
+                    count_[label_[u]]--;
+                    label_[u] = n_;
+                }
+            }
+        }
+    }
+
+    void discharge(uint32_t v) {
+        while (excess_[v] > 0 && label_[v] < n_) {
+            if (current_[v] == r_.offsets[v + 1]) {
+                relabel(v);
+                continue;
+            }
+            uint64_t a = current_[v];
+            uint32_t x = r_.head[a];
+            if (r_.capacity[a] == 0 || label_[v] != label_[x] + 1) {
+                current_[v]++;
+                continue;
+            }
+            uint64_t pushed = std::min(excess_[v], r_.capacity[a]);
+            r_.capacity[a] -= pushed;
+            r_.capacity[r_.reverse[a]] += pushed;
+            excess_[v] -= pushed;
+            excess_[x] += pushed;
+            enqueue(x);
+        }
+    }
+};
+
+uint64_t max_flow(const CsrGraph &csr, uint32_t source, uint32_t sink,
+                  std::vector<Edge> *cut) {
+    if (cut) cut->clear();
+    if (source >= csr.n || sink >= csr.n || !csr.present[source] ||
+        !csr.present[sink] || source == sink)
+        return 0;
+
+    PushRelabel engine(build_residual(csr), csr.n, source, sink);
+    uint64_t flow = engine.run();
+    if (!cut) return flow;
+
+    std::vector<uint8_t> sink_side = engine.sink_side();
+    for (uint32_t v = 0; v < csr.n; v++) {
+        if (sink_side[v]) continue;
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            if (sink_side[u] && csr.out_weights[e] > 0) cut->push_back({v, u});
+        }
+    }
+    return flow;
+}
+
+std::vector<Edge> get_min_cut(Graph &graph, uint32_t source, uint32_t sink,
+                              uint64_t &flow) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<Edge> cut;
+    flow = max_flow(*csr, source, sink, &cut);
+    return cut;
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef FLOW_H_
+#define FLOW_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Computes a maximum flow and a minimum cut with push-relabel.
+ *
+ * Edge weights are the capacities. The residual graph pairs every edge
+ * with a reverse arc taken from the inbound list of its head. Active
+ * vertices are discharged in FIFO order; labels are recomputed by a
+ * backward search from the sink at the start and after every `n`
+ * relabels, and when no vertex is left on some label below `n` (a gap),
+ * every vertex above it is lifted out of the sink's reach at once.
+ *
+ * Only the first phase runs: once no active vertex can reach the sink, the
+ * excess at the sink is the flow value and the vertices that cannot reach
+ * it in the residual graph are the source side of a minimum cut. Excess
+ * left on the source side is not returned to the source.
+ *
+ * @param csr    The graph.
+ * @param source The vertex the flow leaves.
+ * @param sink   The vertex the flow enters.
+ * @param cut    If not null, filled with the edges from the source side to
+ * the sink side of a minimum cut.
+ * @return uint64_t Value of the maximum flow, 0 if either vertex is not in
+ * the graph or they are the same vertex.
+ */
+uint64_t max_flow(const CsrGraph &csr, uint32_t source, uint32_t sink,
+                  std::vector<Edge> *cut = nullptr);
+
+/**
+ * @brief Retrieves a maximum flow and a minimum cut between two vertices.
+ *
+ * @param graph  The graph, with the weights as capacities.
+ * @param source The vertex the flow leaves.
+ * @param sink   The vertex the flow enters.
+ * @param flow   Set to the value of the maximum flow.
+ * @return std::vector<Edge> The edges of a minimum cut.
+ */
+std::vector<Edge> get_min_cut(Graph &graph, uint32_t source, uint32_t sink,
+                              uint64_t &flow);
+
+#endif  // FLOW_H_
@@ -0,0 +1,383 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Data.h"
+#include "Generator.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+// Edges generated, and then formatted, per task
+#define GENERATE_BLOCK (1 << 16)
+// Blocks formatted per worker before they are written out in order
+#define BLOCKS_PER_WORKER 4
+// Edges sorted at once when dropping repeated edges, about 16 bytes each
+#define DEDUP_GROUP_EDGES (1ull << 25)
+// Draws of an R-MAT or power-law edge before falling back to a uniform one
+#define MAX_ATTEMPTS 64
+#define FEISTEL_ROUNDS 4
+// Width of the edge count in text headers written before it is known
+#define COUNT_WIDTH 20
+
+// Everything derived from the settings that edge_at() needs
+struct Sampler {
+    uint32_t model;
+    uint64_t n;
+    uint64_t key;
+    uint32_t max_weight;
+    uint32_t levels;           // bits of a vertex ID, for R-MAT
+    uint64_t quadrant[3];      // R-MAT thresholds out of 2^16
+    double beta;               // power of the rank in the power law
+    double span;               // (n + 1)^(1 - beta) - 1
+    uint32_t high_bits;        // split of the permuted values
+    uint32_t low_bits;
+    uint64_t round_key[FEISTEL_ROUNDS];
+};
+
+// splitmix64 finalizer
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Random word number `lane` of the edge whose base is mix(key + i * phi)
+static uint64_t draw(uint64_t base, uint64_t lane) {
+    return mix(base + lane * 0xd1b54a32d192ed03ULL);
+}
+
+// Uniform in [0, n), biased by at most n / 2^64
+static uint64_t below(uint64_t random, uint64_t n) {
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(random) * n) >> 64);
+}
+
+static double unit(uint64_t random) { return (random >> 11) * 0x1p-53; }
+
+static Sampler make_sampler(const GeneratorSpec &spec) {
+    Sampler s;
+    s.model = spec.model;
+    s.n = spec.vertices;
+    s.key = mix(spec.seed);
+    s.max_weight = spec.max_weight;
+    s.levels = 1;
+    while ((1ull << s.levels) < s.n) s.levels++;
+    double scale = 65536.0;
+    s.quadrant[0] = static_cast<uint64_t>(spec.a * scale);
+    s.quadrant[1] = static_cast<uint64_t>((spec.a + spec.b) * scale);
+    s.quadrant[2] = static_cast<uint64_t>((spec.a + spec.b + spec.c) * scale);
+    s.beta = 1 / (spec.exponent - 1);
+    s.span = std::pow(s.n + 1.0, 1 - s.beta) - 1;
+    s.high_bits = std::max(1u, s.levels / 2);
+    s.low_bits = std::max(1u, s.levels - s.levels / 2);
+    for (int round = 0; round < FEISTEL_ROUNDS; round++)
+        s.round_key[round] = mix(s.key + round + 1);
+    return s;
+}
+
+// Seeded permutation of [0, n): a Feistel network over the bits of n,
+// reapplied while it lands outside. Rounds alternately change the high and
+// the low part of the value, which keeps them invertible when the parts
+// differ in width. The labels only need to look unrelated, so each round
+// is a single multiply.
+static uint32_t permute(const Sampler &s, uint64_t v) {
+    do {
+        uint64_t high = v >> s.low_bits;
+        uint64_t low = v & ((1ull << s.low_bits) - 1);
+        for (int round = 0; round < FEISTEL_ROUNDS; round++) {
+            if (round % 2 == 0)
+                high ^= ((low ^ s.round_key[round]) * 0x9e3779b97f4a7c15ULL) >>
+                        (64 - s.high_bits);
+            else
+                low ^= ((high ^ s.round_key[round]) * 0x9e3779b97f4a7c15ULL) >>
+                       (64 - s.low_bits);
+        }
+        v = high << s.low_bits | low;
+    } while (v >= s.n);
+    return static_cast<uint32_t>(v);
+}
+
+// Vertex of power-law rank drawn by inverting the continuous distribution
+static uint64_t power_law_rank(const Sampler &s, uint64_t random) {
+    double u = unit(random);
+    double x = s.beta == 1 ? std::pow(s.n + 1.0, u)
+                           : std::pow(1 + u * s.span, 1 / (1 - s.beta));
+    uint64_t rank = static_cast<uint64_t>(x) - 1;
+    return std::min(rank, s.n - 1);
+}
+
+static void edge_at(const Sampler &s, uint64_t index, Edge &edge,
+                    uint32_t &weight) {
+    uint64_t base = mix(s.key + index * 0x9e3779b97f4a7c15ULL);
+    weight = static_cast<uint32_t>(below(draw(base, 0), s.max_weight)) + 1;
+
+    uint64_t lane = 1;
+    for (int attempt = 0; s.model != GENERATE_UNIFORM && attempt < MAX_ATTEMPTS;
+         attempt++) {
+        uint64_t parent = 0, child = 0;
+        if (s.model == GENERATE_RMAT) {
+            uint64_t random = 0;
+            for (uint32_t level = 0; level < s.levels; level++) {
+                if (level % 4 == 0) random = draw(base, lane++);
+                uint64_t u = (random >> (level % 4 * 16)) & 0xffff;
+                parent = parent << 1 | (u >= s.quadrant[1]);
+                child = child << 1 | (u >= s.quadrant[0] && u < s.quadrant[1]) |
+                        (u >= s.quadrant[2]);
+            }
+        } else {
+            parent = power_law_rank(s, draw(base, lane++));
+            child = power_law_rank(s, draw(base, lane++));
+        }
+        if (parent < s.n && child < s.n && parent != child) {
+            edge = {permute(s, parent), permute(s, child)};
+            return;
+        }
+    }
+
+    // uniform, with the child drawn among the other vertices
+    uint64_t parent = below(draw(base, lane), s.n);
+    uint64_t child = below(draw(base, lane + 1), s.n - 1);
+    if (child >= parent) child++;
+    edge = {static_cast<uint32_t>(parent), static_cast<uint32_t>(child)};
+}
+
+int check_spec(const GeneratorSpec &spec, std::string &error) {
+    if (spec.model < GENERATE_UNIFORM || spec.model > GENERATE_POWER_LAW) {
+        error = "unknown model";
+    } else if (spec.vertices < 2) {
+        error = "at least 2 vertices are needed";
+    } else if (spec.max_weight == 0) {
+        error = "the largest weight must be at least 1";
+    } else if (spec.model == GENERATE_RMAT &&
+               (spec.a < 0 || spec.b < 0 || spec.c < 0 ||
+                spec.a + spec.b + spec.c > 1)) {
+        error = "R-MAT probabilities must be positive and sum to at most 1";
+    } else if (spec.model == GENERATE_POWER_LAW && !(spec.exponent > 1)) {
+        error = "the power-law exponent must be above 1";
+    } else {
+        return 1;
+    }
+    return 0;
+}
+
+void generate_edges(const GeneratorSpec &spec, uint64_t first, uint64_t last,
+                    std::vector<Edge> &edges, std::vector<uint32_t> &weights) {
+    Sampler s = make_sampler(spec);
+    for (uint64_t i = first; i < last; i++) {
+        Edge edge;
+        uint32_t weight;
+        edge_at(s, i, edge, weight);
+        edges.push_back(edge);
+        weights.push_back(weight);
+    }
+}
+
+static void append_number(std::string &out, uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (count) out.push_back(digits[--count]);
+}
+
+static void append_edge(std::string &out, bool binary, const Edge &edge,
+                        uint32_t weight) {
+    if (binary) {
+        uint32_t record[3] = {edge.parent, edge.child, weight};
+        out.append(reinterpret_cast<const char *>(record), sizeof(record));
+        return;
+    }
+    append_number(out, edge.parent);
+    out.push_back(' ');
+    append_number(out, edge.child);
+    out.push_back(' ');
+    append_number(out, weight);
+    out.push_back('\n');
+}
+
+// Fills the buffers of `blocks` blocks in parallel, a round at a time, and
+// writes them out in block order
+template <typename Fill>
+static void write_blocks(std::ofstream &output, uint64_t blocks, Fill fill) {
+    uint64_t round = uint64_t(worker_count()) * BLOCKS_PER_WORKER;
+    std::vector<std::string> buffers(round);
+    for (uint64_t start = 0; start < blocks; start += round) {
+        uint64_t count = std::min(round, blocks - start);
+        parallel_for(
+            0, count,
+            [&](size_t from, size_t to) {
+                for (size_t k = from; k < to; k++) {
+                    buffers[k].clear();
+                    fill(start + k, buffers[k]);
+                }
+            },
+            1);
+        for (uint64_t k = 0; k < count; k++)
+            output.write(buffers[k].data(), buffers[k].size());
+    }
+}
+
+struct Record {
+    uint64_t key;  // parent in the high half, child in the low one
+    uint32_t weight;
+};
+
+// Writes the edges without repeats, one group of parents at a time
+static uint64_t write_deduplicated(std::ofstream &output, const Sampler &s,
+                                   uint64_t edges, bool binary) {
+    uint64_t groups = std::max<uint64_t>(
+        1, (edges + DEDUP_GROUP_EDGES - 1) / DEDUP_GROUP_EDGES);
+    uint64_t blocks = (edges + GENERATE_BLOCK - 1) / GENERATE_BLOCK;
+    uint64_t written = 0;
+    std::vector<Record> records;
+    std::mutex merge;
+    for (uint64_t group = 0; group < groups; group++) {
+        records.clear();
+        parallel_for(
+            0, blocks,
+            [&](size_t from, size_t to) {
+                std::vector<Record> local;
+                for (uint64_t i = from * uint64_t(GENERATE_BLOCK);
+                     i < std::min(edges, to * uint64_t(GENERATE_BLOCK)); i++) {
+                    Edge edge;
+                    uint32_t weight;
+                    edge_at(s, i, edge, weight);
+                    if (edge.parent % groups != group) continue;
+                    local.push_back(
+                        {uint64_t(edge.parent) << 32 | edge.child, weight});
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                records.insert(records.end(), local.begin(), local.end());
+            },
+            1);
+
+        // the lowest weight of repeated edges is kept, whichever thread
+        // generated which
+        std::sort(records.begin(), records.end(),
+                  [](const Record &x, const Record &y) {
+                      return x.key < y.key ||
+                             (x.key == y.key && x.weight < y.weight);
+                  });
+        records.erase(std::unique(records.begin(), records.end(),
+                                  [](const Record &x, const Record &y) {
+                                      return x.key == y.key;
+                                  }),
+                      records.end());
+
+        write_blocks(output,
+                     (records.size() + GENERATE_BLOCK - 1) / GENERATE_BLOCK,
+                     [&](uint64_t block, std::string &out) {
+                         uint64_t first = block * GENERATE_BLOCK;
+                         uint64_t last = std::min<uint64_t>(
+                             records.size(), first + GENERATE_BLOCK);
+                         for (uint64_t k = first; k < last; k++) {
+                             Edge edge = {
+                                 static_cast<uint32_t>(records[k].key >> 32),
+                                 static_cast<uint32_t>(records[k].key)};
+                             append_edge(out, binary, edge, records[k].weight);
+                         }
+                     });
+        written += records.size();
+    }
+    return written;
+}
+
+int write_generated_graph(const GeneratorSpec &spec,
+                          const std::string &filename, bool binary,
+                          uint64_t &written) {
+    written = 0;
+    std::string error;
+    if (!check_spec(spec, error)) {
+        std::cerr << "Cannot generate the graph: " << error << "\n";
+        return 0;
+    }
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open file " << filename << std::endl;
+        return 0;
+    }
+
+    // the edge count of a deduplicated graph is filled in at the end
+    std::streampos count_at;
+    if (binary) {
+        output.write(GRAPH_BINARY_MAGIC, sizeof(GRAPH_BINARY_MAGIC));
+        output.write(reinterpret_cast<const char *>(&spec.vertices),
+                     sizeof(spec.vertices));
+        count_at = output.tellp();
+        output.write(reinterpret_cast<const char *>(&spec.edges),
+                     sizeof(spec.edges));
+    } else {
+        output << spec.vertices << " ";
+        count_at = output.tellp();
+        if (spec.dedup)
+            output << std::string(COUNT_WIDTH, ' ') << "\n";
+        else
+            output << spec.edges << "\n";
+    }
+
+    Sampler s = make_sampler(spec);
+    if (spec.dedup) {
+        written = write_deduplicated(output, s, spec.edges, binary);
+        output.seekp(count_at);
+        if (binary)
+            output.write(reinterpret_cast<const char *>(&written),
+                         sizeof(written));
+        else
+            output << written;
+    } else {
+        uint64_t blocks = (spec.edges + GENERATE_BLOCK - 1) / GENERATE_BLOCK;
+        write_blocks(output, blocks, [&](uint64_t block, std::string &out) {
+            uint64_t first = block * GENERATE_BLOCK;
+            uint64_t last = std::min<uint64_t>(spec.edges,
+                                               first + GENERATE_BLOCK);
+            for (uint64_t i = first; i < last; i++) {
+                Edge edge;
+                uint32_t weight;
+                edge_at(s, i, edge, weight);
+                append_edge(out, binary, edge, weight);
+            }
+        });
+        written = spec.edges;
+    }
+
+    output.close();
+    if (!output) {
+        std::cerr << "Failed to write file " << filename << std::endl;
+        return 0;
+    }
+    return 1;
+}
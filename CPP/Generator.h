@@ -0,0 +1,118 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef GENERATOR_H_
+#define GENERATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Structures.h"
+
+// Models of random graphs
+#define GENERATE_UNIFORM 1    ///< Erdos-Renyi: endpoints drawn uniformly.
+#define GENERATE_RMAT 2       ///< R-MAT (Kronecker) recursive quadrants.
+#define GENERATE_POWER_LAW 3  ///< Chung-Lu with power-law expected degrees.
+
+/**
+ * @brief Settings of a random graph.
+ *
+ * Edge i of the graph is a function of the settings and i alone: its
+ * endpoints and weight are drawn from a counter-based generator keyed by
+ * the seed and i, so any range of edges can be generated on its own, by
+ * any thread, and always comes out the same. Self-loops are redrawn.
+ *
+ * R-MAT puts an edge in one of the four quadrants of the adjacency matrix
+ * with probabilities a, b, c and 1 - a - b - c, and recurses into it once
+ * per bit of the vertex IDs. The power-law model draws both endpoints with
+ * probability proportional to (rank + 1)^(-1 / (exponent - 1)), which gives
+ * degrees following a power law with that exponent. Both models number
+ * the vertices by a seeded permutation, so the hubs are spread over the
+ * ID range instead of all being the lowest IDs.
+ */
+struct GeneratorSpec {
+    uint32_t model = GENERATE_UNIFORM;  ///< One of the GENERATE_ models.
+    uint32_t vertices = 0;              ///< IDs are 0 .. vertices - 1.
+    uint64_t edges = 0;                 ///< Edges drawn.
+    uint64_t seed = 1;                  ///< Seed of the generator.
+    double a = 0.57;                    ///< R-MAT top left probability.
+    double b = 0.19;                    ///< R-MAT top right probability.
+    double c = 0.19;                    ///< R-MAT bottom left probability.
+    double exponent = 2.1;              ///< Exponent of the power law.
+    uint32_t max_weight = 100;          ///< Weights are 1 .. max_weight.
+    bool dedup = false;                 ///< Drop repeated edges.
+};
+
+/**
+ * @brief Checks that settings describe a graph that can be generated.
+ * @param spec  The settings.
+ * @param error Set to the reason when they do not.
+ * @return int 1 if they are valid, 0 otherwise.
+ */
+int check_spec(const GeneratorSpec &spec, std::string &error);
+
+/**
+ * @brief Generates edges [first, last) of a random graph.
+ *
+ * Repeated edges are not dropped here, whatever `spec.dedup` says.
+ * @param spec    The settings, checked with check_spec().
+ * @param first   Index of the first edge.
+ * @param last    One past the index of the last edge.
+ * @param edges   Appended the edges.
+ * @param weights Appended their weights.
+ */
+void generate_edges(const GeneratorSpec &spec, uint64_t first, uint64_t last,
+                    std::vector<Edge> &edges, std::vector<uint32_t> &weights);
+
+/**
+ * @brief Generates a random graph in parallel and writes it to a file.
+ *
+ * Text files have the format read_data() reads: the numbers of vertices
+ * and edges on the first line, then one "parent child weight" line per
+ * edge. Binary files start with GRAPH_BINARY_MAGIC, the number of
+ * vertices as a uint32_t and of edges as a uint64_t, followed by every
+ * edge as three uint32_t (parent, child, weight) in the machine's byte
+ * order; read_data() reads those too.
+ *
+ * Without dedup the edges are written in index order. With dedup they are
+ * generated once per group of parents small enough to sort in memory, and
+ * written sorted by parent and child within each group; of repeated
+ * edges, the one with the lowest weight is kept, so the file has fewer
+ * edges than `spec.edges`. Either way the file only depends on the
+ * settings, not on the number of threads.
+ *
+ * @param spec     The settings.
+ * @param filename Name of the file to write.
+ * @param binary   Whether to write the binary format.
+ * @param written  Set to the number of edges written.
+ * @return int 1 on success, 0 if the settings are invalid or the file
+ * could not be written.
+ */
+int write_generated_graph(const GeneratorSpec &spec,
+                          const std::string &filename, bool binary,
+                          uint64_t &written);
+
+#endif  // GENERATOR_H_
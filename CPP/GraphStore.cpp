@@ -0,0 +1,264 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Adjacency.h"
+#include "Connectivity.h"
+#include "Csr.h"
+#include "Data.h"
+#include "Generator.h"
+#include "GraphStore.h"
+#include "Hierarchy.h"
+#include "Landmarks.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+// Edges generated per task when building a random graph
+#define GENERATED_BLOCK (1 << 16)
+
+Graph *new_graph() {
+    Graph *graph = new Graph();
+    graph->inbound.reset(new AdjacencyMap(), release_adjacency);
+    graph->outbound.reset(new AdjacencyMap(), release_adjacency);
+    graph->costs = std::make_shared<CostMap>();
+    graph->manager = std::make_shared<IdManager>();
+    return graph;
+}
+
+Graph *fork_graph(const Graph &graph) { return new Graph(graph); }
+
+static void detach_adjacency(std::shared_ptr<AdjacencyMap> &map) {
+    if (map.use_count() > 1) {
+        map.reset(new AdjacencyMap(map), release_adjacency);
+    } else {
+        map->fold();
+    }
+}
+
+void detach_graph(Graph &graph) {
+    detach_adjacency(graph.inbound);
+    detach_adjacency(graph.outbound);
+    if (graph.costs.use_count() > 1) {
+        graph.costs = std::make_shared<CostMap>(graph.costs);
+    } else {
+        graph.costs->fold();
+    }
+    if (graph.manager.use_count() > 1) {
+        // the new map keeps the whole manager it is stacked on alive
+        std::shared_ptr<const IdMap> map(graph.manager, &graph.manager->map);
+        std::shared_ptr<IdManager> manager = std::make_shared<IdManager>();
+        manager->map.base = map;
+        manager->map.entries = map->size();
+        manager->unused_ids = graph.manager->unused_ids;
+        manager->max_vertex = graph.manager->max_vertex;
+        graph.manager = manager;
+    } else {
+        graph.manager->map.fold();
+    }
+    // a shared index is left to the other side rather than copied; this
+    // one is rebuilt if it is used again
+    if (graph.connectivity.use_count() > 1) graph.connectivity.reset();
+}
+
+void begin_mutation(Graph &graph, bool lengthens_only) {
+    detach_graph(graph);
+    graph.csr.reset();
+    if (!lengthens_only) graph.landmarks.reset();
+    graph.hierarchy.reset();
+}
+
+void graph_fingerprint(const Graph &graph, uint64_t &edges,
+                       uint64_t &weight) {
+    edges = graph.costs->size();
+    weight = 0;
+    for (const auto &entry : *graph.costs) weight += entry.second;
+}
+
+Graph *load_graph(const char *filename, uint32_t vertex_buffer) {
+    Graph *graph = new_graph();
+    read_data(*graph->inbound, *graph->outbound, *graph->costs,
+              graph->vertices, graph->edges, filename, vertex_buffer,
+              *graph->manager);
+    if (graph->vertices == 0) {
+        // read_data already reported why the file could not be loaded
+        free_graph(graph);
+        return nullptr;
+    }
+    graph->landmarks = load_landmarks(*graph, landmark_file(filename));
+    graph->hierarchy = load_hierarchy(*graph, hierarchy_file(filename));
+    return graph;
+}
+
+// Adjacency list of one vertex from its sorted CSR neighbors
+static uint32_t *copy_list(const std::vector<uint32_t> &neighbors,
+                           uint64_t from, uint64_t to, bool dedup,
+                           uint32_t vertex_buffer, uint64_t &repeats) {
+    uint64_t repeated = 0;
+    for (uint64_t e = from + 1; e < to; e++)
+        repeated += neighbors[e] == neighbors[e - 1];
+    repeats += repeated;
+    uint32_t size = static_cast<uint32_t>(to - from - (dedup ? repeated : 0));
+    uint32_t *list = alloc_list(size + 1 + vertex_buffer);
+    list[0] = 0;
+    for (uint64_t e = from; e < to; e++) {
+        if (dedup && e > from && neighbors[e] == neighbors[e - 1]) continue;
+        list[++list[0]] = neighbors[e];
+    }
+    return list;
+}
+
+Graph *generate_graph(const GeneratorSpec &spec, uint32_t vertex_buffer) {
+    std::string error;
+    if (!check_spec(spec, error)) {
+        std::cerr << "Cannot generate the graph: " << error << "\n";
+        return nullptr;
+    }
+    if (spec.edges > UINT32_MAX) {
+        std::cerr << "Cannot generate the graph: a graph in memory holds at "
+                     "most "
+                  << UINT32_MAX << " edges\n";
+        return nullptr;
+    }
+    uint32_t n = spec.vertices;
+
+    std::vector<Edge> edges(spec.edges);
+    std::vector<uint32_t> weights(spec.edges);
+    parallel_for(
+        0, spec.edges,
+        [&](size_t from, size_t to) {
+            std::vector<Edge> block;
+            std::vector<uint32_t> block_weights;
+            generate_edges(spec, from, to, block, block_weights);
+            std::copy(block.begin(), block.end(), edges.begin() + from);
+            std::copy(block_weights.begin(), block_weights.end(),
+                      weights.begin() + from);
+        },
+        GENERATED_BLOCK);
+    // lists come out sorted by neighbor and then weight, so the first copy
+    // of a repeated edge is the lightest
+    std::shared_ptr<const CsrGraph> csr = build_csr(n, edges, weights);
+    std::vector<Edge>().swap(edges);
+    std::vector<uint32_t>().swap(weights);
+
+    std::vector<uint32_t *> out_lists(n), in_lists(n);
+    std::atomic<uint64_t> repeats(0), kept(0);
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        uint64_t local_repeats = 0, local_kept = 0, ignored = 0;
+        for (size_t v = from; v < to; v++) {
+            out_lists[v] = copy_list(csr->out_targets, csr->out_offsets[v],
+                                     csr->out_offsets[v + 1], spec.dedup,
+                                     vertex_buffer, local_repeats);
+            in_lists[v] = copy_list(csr->in_sources, csr->in_offsets[v],
+                                    csr->in_offsets[v + 1], spec.dedup,
+                                    vertex_buffer, ignored);
+            local_kept += out_lists[v][0];
+        }
+        repeats += local_repeats;
+        kept += local_kept;
+    });
+
+    Graph *graph = new_graph();
+    graph->outbound->reserve(n);
+    graph->inbound->reserve(n);
+    graph->manager->map.reserve(n);
+    for (uint32_t v = 0; v < n; v++) {
+        (*graph->outbound)[v] = out_lists[v];
+        (*graph->inbound)[v] = in_lists[v];
+        graph->manager->map[v] = v;
+    }
+    graph->manager->max_vertex = n;
+    graph->costs->reserve(kept.load());
+    for (uint32_t v = 0; v < n; v++) {
+        for (uint64_t e = csr->out_offsets[v]; e < csr->out_offsets[v + 1];
+             e++) {
+            if (e > csr->out_offsets[v] &&
+                csr->out_targets[e] == csr->out_targets[e - 1])
+                continue;
+            graph->costs->emplace(std::make_pair(v, csr->out_targets[e]),
+                                  csr->out_weights[e]);
+        }
+    }
+    graph->vertices = n;
+    graph->edges = static_cast<uint32_t>(kept.load());
+    // with repeats, the copy's weights differ from the graph's
+    if (repeats.load() == 0) graph->csr = csr;
+    return graph;
+}
+
+void free_graph(Graph *graph) { delete graph; }
+
+void free_graph_async(Graph *graph) {
+    if (graph == nullptr) return;
+    spawn_background_detached([graph]() { free_graph(graph); });
+}
+
+int start_reload(GraphReloader &reloader, const char *filename,
+                 uint32_t vertex_buffer) {
+    if (reloader.running.load()) return 0;
+    // the previous load has already published its result, so this does not
+    // block
+    wait(reloader.load);
+
+    reloader.filename = filename;
+    reloader.running.store(true);
+    spawn_background(reloader.load, [&reloader, vertex_buffer]() {
+        Graph *graph = load_graph(reloader.filename.c_str(), vertex_buffer);
+        if (graph == nullptr) {
+            std::cerr << "Reload of " << reloader.filename << " failed\n";
+        }
+        reloader.loaded.store(graph);
+        reloader.running.store(false);
+    });
+    return 1;
+}
+
+void replace_graph(std::atomic<Graph *> &current,
+                   std::vector<Graph *> &parents, Graph *graph) {
+    free_graph_async(current.exchange(graph));
+    for (Graph *parent : parents) free_graph_async(parent);
+    if (!parents.empty()) std::cout << "Open forks were discarded\n";
+    parents.clear();
+}
+
+int poll_reload(GraphReloader &reloader, std::atomic<Graph *> &current,
+                std::vector<Graph *> &parents) {
+    Graph *graph = reloader.loaded.exchange(nullptr);
+    if (graph == nullptr) return 0;
+
+    replace_graph(current, parents, graph);
+    std::cout << "Switched to graph " << reloader.filename << "\n";
+    return 1;
+}
+
+void stop_reload(GraphReloader &reloader) {
+    wait(reloader.load);
+    free_graph(reloader.loaded.exchange(nullptr));
+}
@@ -0,0 +1,202 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef GRAPHSTORE_H_
+#define GRAPHSTORE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Generator.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+/**
+ * @brief State of a graph being loaded in the background.
+ *
+ * A job on the background thread builds a separate Graph instance and
+ * publishes it through `loaded` once reading is done; the thread serving
+ * requests picks it up with poll_reload().
+ */
+struct GraphReloader {
+    TaskGroup load;                        ///< The task running read_data.
+    std::atomic<Graph *> loaded{nullptr};  ///< Published once loading ends.
+    std::atomic<bool> running{false};      ///< Set while a load is ongoing.
+    std::string filename;                  ///< File being loaded.
+};
+
+/**
+ * @brief Creates an empty graph with tables of its own.
+ * @return Graph* The new graph.
+ * @note The caller is responsible for releasing the graph with free_graph().
+ */
+Graph *new_graph();
+
+/**
+ * @brief Creates a copy-on-write fork of a graph in constant time.
+ *
+ * The fork shares every table and adjacency list with the original. Before
+ * either side is modified, detach_graph() stacks an empty layer of its own on
+ * each shared table; entries and lists are copied into it one by one as
+ * vertices and edges are modified.
+ *
+ * @param graph The graph to fork.
+ * @return Graph* The fork.
+ * @note The caller is responsible for releasing the fork with free_graph().
+ */
+Graph *fork_graph(const Graph &graph);
+
+/**
+ * @brief Gives a graph its own tables if they are shared with a fork.
+ *
+ * Takes constant time for a shared table, which gets an empty layer on top.
+ * A table no longer shared is merged into the layers below it that no other
+ * graph uses, in time proportional to its own entries. The connectivity
+ * index is dropped if shared. Must be called before modifying a graph that
+ * may have forks.
+ *
+ * @param graph The graph about to be modified.
+ */
+void detach_graph(Graph &graph);
+
+/**
+ * @brief Prepares a graph for modification.
+ *
+ * Detaches the tables shared with forks and drops the views derived from the
+ * graph's current contents. The landmark table is kept when distances can
+ * only grow: its bounds then stay valid, if less tight. The contraction
+ * hierarchy is always dropped, as its shortcuts may no longer be paths.
+ *
+ * @param graph          The graph about to be modified.
+ * @param lengthens_only The change only removes edges or vertices, or adds
+ * vertices without edges.
+ */
+void begin_mutation(Graph &graph, bool lengthens_only = false);
+
+/**
+ * @brief Summarizes a graph independently of how its vertex IDs were
+ * assigned.
+ *
+ * Files derived from a graph (landmarks, hierarchies) store it to check
+ * that they are loaded next to the same graph.
+ *
+ * @param graph  The graph.
+ * @param edges  Set to the number of edges.
+ * @param weight Set to the total weight of the edges.
+ */
+void graph_fingerprint(const Graph &graph, uint64_t &edges,
+                       uint64_t &weight);
+
+/**
+ * @brief Loads a graph from a file into a new instance.
+ *
+ * @param filename      Name of the file to read from.
+ * @param vertex_buffer Buffer size for vertex storage.
+ * @return Graph* The loaded graph, or nullptr if the file could not be read.
+ * @note The caller is responsible for releasing the graph with free_graph().
+ */
+Graph *load_graph(const char *filename, uint32_t vertex_buffer);
+
+/**
+ * @brief Builds a random graph in memory, without going through a file.
+ *
+ * Edges are generated in parallel and sorted into lists by a CSR build,
+ * from which the adjacency lists are copied in parallel; only the hash
+ * tables are filled by a single thread. Vertex v of the generator gets
+ * internal ID v and file ID v, and every vertex gets lists with
+ * `vertex_buffer` spare cells, as if the graph had been read from a file.
+ * Copies of a repeated edge all get the lowest of their weights, and with
+ * `spec.dedup` only one copy is kept. When no edge repeats, the CSR copy
+ * is kept in the graph.
+ *
+ * @param spec          The settings of the generator.
+ * @param vertex_buffer Spare cells of every adjacency list.
+ * @return Graph* The graph, or nullptr if the settings are invalid or ask
+ * for more than UINT32_MAX edges.
+ * @note The caller is responsible for releasing the graph with free_graph().
+ */
+Graph *generate_graph(const GeneratorSpec &spec, uint32_t vertex_buffer);
+
+/**
+ * @brief Frees a graph, along with the lists no fork still uses.
+ * @param graph The graph to free.
+ */
+void free_graph(Graph *graph);
+
+/**
+ * @brief Frees a graph on the background thread so the caller does not
+ * wait.
+ * @param graph The graph to free.
+ */
+void free_graph_async(Graph *graph);
+
+/**
+ * @brief Replaces the graph in use with an unrelated one.
+ *
+ * The forks the current graph descends from belong to the graph being
+ * replaced, so they are freed as well; discarding a fork afterwards cannot
+ * bring back a graph from before the replacement.
+ *
+ * @param current Pointer to the graph currently in use.
+ * @param parents Graphs the current one was forked from, emptied.
+ * @param graph   The new graph.
+ */
+void replace_graph(std::atomic<Graph *> &current,
+                   std::vector<Graph *> &parents, Graph *graph);
+
+/**
+ * @brief Starts loading a graph in the background.
+ *
+ * @param reloader      The reloader state.
+ * @param filename      Name of the file to read from.
+ * @param vertex_buffer Buffer size for vertex storage.
+ * @return int 1 if the load was started, 0 if one is already running.
+ */
+int start_reload(GraphReloader &reloader, const char *filename,
+                 uint32_t vertex_buffer);
+
+/**
+ * @brief Swaps in the graph loaded in the background, if it is ready.
+ *
+ * The swap goes through replace_graph(): a single atomic exchange of the
+ * pointer to the current graph, the replaced instance and its parents are
+ * freed asynchronously.
+ *
+ * @param reloader The reloader state.
+ * @param current  Pointer to the graph currently in use.
+ * @param parents  Graphs the current one was forked from.
+ * @return int 1 if the graph was swapped, 0 otherwise.
+ */
+int poll_reload(GraphReloader &reloader, std::atomic<Graph *> &current,
+                std::vector<Graph *> &parents);
+
+/**
+ * @brief Waits for a running reload and discards its result.
+ * @param reloader The reloader state.
+ */
+void stop_reload(GraphReloader &reloader);
+
+#endif  // GRAPHSTORE_H_
@@ -0,0 +1,678 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Csr.h"
+#include "GraphStore.h"
+#include "Hierarchy.h"
+#include "Parallel.h"
+#include "ShortestPath.h"
+#include "Structures.h"
+
+// Vertices a witness search may settle before it gives up and the shortcut
+// is added anyway; priorities only estimate the shortcuts and make do with
+// shorter searches
+#define CH_WITNESS_SETTLED 256
+#define CH_PRIORITY_SETTLED 32
+// Contraction stops once the remaining vertices have this many edges on
+// average; graphs without a road-like hierarchy would otherwise end up
+// with a quadratic number of shortcuts
+#define CH_CORE_DEGREE 16
+
+static const char HIERARCHY_MAGIC[4] = {'C', 'H', '0', '1'};
+
+struct Arc {
+    uint32_t vertex;
+    uint32_t weight;
+    uint32_t middle;  // bypassed vertex, UINT32_MAX for original edges
+};
+
+struct Shortcut {
+    uint32_t from;
+    uint32_t to;
+    uint32_t weight;
+};
+
+// Edge of a path found by a query, `middle` as in Arc
+struct PathEdge {
+    uint32_t from;
+    uint32_t to;
+    uint32_t middle;
+};
+
+static inline uint32_t add_weights(uint64_t a, uint64_t b) {
+    return static_cast<uint32_t>(std::min<uint64_t>(a + b, UINT32_MAX));
+}
+
+// State of the local searches, handed out to one chunk of a parallel loop
+// at a time so it is allocated once per thread and not once per round
+struct WitnessSpace {
+    std::vector<uint64_t> dist;
+    std::vector<uint32_t> touched;
+    std::vector<uint8_t> target;  // neighbors the search has to settle
+    RadixHeap heap;
+};
+
+class WitnessPool {
+ public:
+    explicit WitnessPool(uint32_t n) : n_(n) {}
+
+    std::unique_ptr<WitnessSpace> acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            std::unique_ptr<WitnessSpace> ws(new WitnessSpace());
+            ws->dist.assign(n_, UNREACHABLE);
+            ws->target.assign(n_, 0);
+            return ws;
+        }
+        std::unique_ptr<WitnessSpace> ws = std::move(free_.back());
+        free_.pop_back();
+        return ws;
+    }
+
+    void release(std::unique_ptr<WitnessSpace> ws) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(ws));
+    }
+
+ private:
+    uint32_t n_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<WitnessSpace>> free_;
+};
+
+// The graph of the vertices not contracted yet
+struct Contractor {
+    std::vector<std::vector<Arc>> out, in;
+    std::vector<uint8_t> blocked;  // contracted, or being contracted
+    std::vector<int64_t> priority;
+    std::vector<uint32_t> deleted;  // contracted neighbors
+    std::vector<uint32_t> depth;
+};
+
+// Distances from `source` avoiding `skip` and blocked vertices, up to
+// `limit`, until the `targets` marked in ws.target are settled, or until
+// `max_settled` vertices are settled
+static void witness_search(const Contractor &c, uint32_t source,
+                           uint32_t skip, uint64_t limit, uint32_t targets,
+                           uint32_t max_settled, WitnessSpace &ws) {
+    for (uint32_t v : ws.touched) ws.dist[v] = UNREACHABLE;
+    ws.touched.clear();
+    for (auto &bucket : ws.heap.buckets) bucket.clear();
+    ws.heap.size = 0;
+    ws.heap.last = 0;
+
+    ws.dist[source] = 0;
+    ws.touched.push_back(source);
+    ws.heap.push(0, source);
+    uint32_t settled = 0;
+    while (ws.heap.size) {
+        std::pair<uint64_t, uint32_t> top = ws.heap.pop();
+        uint64_t d = top.first;
+        uint32_t v = top.second;
+        if (d != ws.dist[v]) continue;
+        if (d > limit || ++settled > max_settled) break;
+        if (ws.target[v] && --targets == 0) break;
+        for (const Arc &arc : c.out[v]) {
+            uint32_t u = arc.vertex;
+            if (u == skip || c.blocked[u]) continue;
+            uint64_t candidate = d + arc.weight;
+            if (candidate >= ws.dist[u]) continue;
+            if (ws.dist[u] == UNREACHABLE) ws.touched.push_back(u);
+            ws.dist[u] = candidate;
+            ws.heap.push(candidate, u);
+        }
+    }
+}
+
+// Shortcuts needed to contract x: a path u -> x -> v needs one unless a
+// witness path avoiding x is at most as long
+static uint32_t find_shortcuts(const Contractor &c, uint32_t x,
+                               WitnessSpace &ws,
+                               std::vector<Shortcut> *found) {
+    uint32_t count = 0;
+    for (const Arc &out : c.out[x]) ws.target[out.vertex] = 1;
+    for (const Arc &in : c.in[x]) {
+        uint32_t u = in.vertex;
+        uint64_t limit = 0;
+        uint32_t targets = 0;
+        for (const Arc &out : c.out[x]) {
+            if (out.vertex == u) continue;
+            limit = std::max<uint64_t>(limit, in.weight + out.weight);
+            targets++;
+        }
+        if (!targets) continue;
+        // u is settled first but is not a target of its own search
+        witness_search(c, u, x, limit, targets + ws.target[u],
+                       found ? CH_WITNESS_SETTLED : CH_PRIORITY_SETTLED, ws);
+        for (const Arc &out : c.out[x]) {
+            uint32_t v = out.vertex;
+            if (v == u) continue;
+            uint32_t via = add_weights(in.weight, out.weight);
+            if (ws.dist[v] <= via) continue;
+            count++;
+            if (found) found->push_back({u, v, via});
+        }
+    }
+    for (const Arc &out : c.out[x]) ws.target[out.vertex] = 0;
+    return count;
+}
+
+static int64_t compute_priority(const Contractor &c, uint32_t x,
+                                WitnessSpace &ws) {
+    int64_t edge_difference =
+        static_cast<int64_t>(find_shortcuts(c, x, ws, nullptr)) -
+        static_cast<int64_t>(c.in[x].size() + c.out[x].size());
+    return 4 * edge_difference + 2 * c.deleted[x] + c.depth[x];
+}
+
+// Adds an arc or shortens the existing one, returns 1 if it is new
+static int add_arc(std::vector<Arc> &arcs, uint32_t vertex, uint32_t weight,
+                   uint32_t middle) {
+    for (Arc &arc : arcs) {
+        if (arc.vertex != vertex) continue;
+        if (weight < arc.weight) arc = {vertex, weight, middle};
+        return 0;
+    }
+    arcs.push_back({vertex, weight, middle});
+    return 1;
+}
+
+static void remove_arc(std::vector<Arc> &arcs, uint32_t vertex) {
+    for (size_t i = 0; i < arcs.size(); i++) {
+        if (arcs[i].vertex != vertex) continue;
+        arcs[i] = arcs.back();
+        arcs.pop_back();
+        return;
+    }
+}
+
+// Flattens per-vertex arc lists into CSR arrays
+static void flatten(const std::vector<std::vector<Arc>> &lists,
+                    std::vector<uint64_t> &offsets,
+                    std::vector<uint32_t> &heads,
+                    std::vector<uint32_t> &weights,
+                    std::vector<uint32_t> &middle) {
+    size_t n = lists.size();
+    offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; v++)
+        offsets[v + 1] = offsets[v] + lists[v].size();
+    heads.resize(offsets[n]);
+    weights.resize(offsets[n]);
+    middle.resize(offsets[n]);
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++) {
+            uint64_t at = offsets[v];
+            for (const Arc &arc : lists[v]) {
+                heads[at] = arc.vertex;
+                weights[at] = arc.weight;
+                middle[at] = arc.middle;
+                at++;
+            }
+        }
+    });
+}
+
+std::shared_ptr<const ContractionHierarchy> build_hierarchy(
+    const CsrGraph &csr) {
+    uint32_t n = csr.n;
+    Contractor c;
+    c.out.resize(n);
+    c.in.resize(n);
+    c.blocked.assign(n, 0);
+    c.priority.assign(n, 0);
+    c.deleted.assign(n, 0);
+    c.depth.assign(n, 0);
+    for (uint32_t v = 0; v < n; v++) {
+        if (!csr.present[v]) c.blocked[v] = 1;
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            if (u == v) continue;  // loops are never on a shortest path
+            add_arc(c.out[v], u, csr.out_weights[e], UINT32_MAX);
+            add_arc(c.in[u], v, csr.out_weights[e], UINT32_MAX);
+        }
+    }
+
+    std::shared_ptr<ContractionHierarchy> ch =
+        std::make_shared<ContractionHierarchy>();
+    ch->n = n;
+    ch->rank.assign(n, UINT32_MAX);
+    std::vector<std::vector<Arc>> up(n), down(n);
+
+    WitnessPool pool(n);
+    std::vector<uint32_t> remaining;
+    for (uint32_t v = 0; v < n; v++) {
+        if (!c.blocked[v]) remaining.push_back(v);
+    }
+    auto update_priorities = [&](const std::vector<uint32_t> &vertices) {
+        parallel_for(
+            0, vertices.size(),
+            [&](size_t from, size_t to) {
+                std::unique_ptr<WitnessSpace> ws = pool.acquire();
+                for (size_t i = from; i < to; i++)
+                    c.priority[vertices[i]] =
+                        compute_priority(c, vertices[i], *ws);
+                pool.release(std::move(ws));
+            },
+            64);
+    };
+    update_priorities(remaining);
+
+    uint32_t next_rank = 0;
+    uint64_t arcs = csr.m;
+    std::vector<uint8_t> touched(n, 0);
+    std::vector<uint32_t> batch, neighbors;
+    std::vector<std::vector<Shortcut>> found;
+    std::mutex merge;
+    while (!remaining.empty() && arcs <= CH_CORE_DEGREE * remaining.size()) {
+        // a vertex is contracted this round if it comes before all its
+        // neighbors in (priority, ID) order
+        auto before = [&](uint32_t a, uint32_t b) {
+            return c.priority[a] < c.priority[b] ||
+                   (c.priority[a] == c.priority[b] && a < b);
+        };
+        batch.clear();
+        parallel_for(
+            0, remaining.size(),
+            [&](size_t from, size_t to) {
+                std::vector<uint32_t> local;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t x = remaining[i];
+                    bool minimum = true;
+                    for (const Arc &arc : c.in[x])
+                        minimum = minimum && before(x, arc.vertex);
+                    for (const Arc &arc : c.out[x])
+                        minimum = minimum && before(x, arc.vertex);
+                    if (minimum) local.push_back(x);
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                batch.insert(batch.end(), local.begin(), local.end());
+            },
+            256);
+        std::sort(batch.begin(), batch.end());
+        for (uint32_t x : batch) c.blocked[x] = 1;
+
+        // witness searches avoid the whole batch, so two vertices of it
+        // cannot each rely on a path through the other
+        found.assign(batch.size(), std::vector<Shortcut>());
+        parallel_for(
+            0, batch.size(),
+            [&](size_t from, size_t to) {
+                std::unique_ptr<WitnessSpace> ws = pool.acquire();
+                for (size_t i = from; i < to; i++)
+                    find_shortcuts(c, batch[i], *ws, &found[i]);
+                pool.release(std::move(ws));
+            },
+            16);
+
+        neighbors.clear();
+        for (size_t i = 0; i < batch.size(); i++) {
+            uint32_t x = batch[i];
+            ch->rank[x] = next_rank++;
+            up[x].swap(c.out[x]);
+            down[x].swap(c.in[x]);
+            arcs -= up[x].size() + down[x].size();
+            for (const Arc &arc : down[x]) remove_arc(c.out[arc.vertex], x);
+            for (const Arc &arc : up[x]) remove_arc(c.in[arc.vertex], x);
+            for (int side = 0; side < 2; side++) {
+                for (const Arc &arc : side ? up[x] : down[x]) {
+                    uint32_t y = arc.vertex;
+                    c.deleted[y]++;
+                    c.depth[y] = std::max(c.depth[y], c.depth[x] + 1);
+                    if (!touched[y]) {
+                        touched[y] = 1;
+                        neighbors.push_back(y);
+                    }
+                }
+            }
+            for (const Shortcut &s : found[i]) {
+                int added = add_arc(c.out[s.from], s.to, s.weight, x);
+                add_arc(c.in[s.to], s.from, s.weight, x);
+                ch->shortcuts += added;
+                arcs += added;
+            }
+        }
+        for (uint32_t y : neighbors) touched[y] = 0;
+        update_priorities(neighbors);
+
+        remaining.erase(
+            std::remove_if(remaining.begin(), remaining.end(),
+                           [&](uint32_t v) { return c.blocked[v]; }),
+            remaining.end());
+    }
+
+    // the core keeps its edges both ways and is searched like a plain graph
+    ch->core = static_cast<uint32_t>(remaining.size());
+    for (uint32_t x : remaining) {
+        ch->rank[x] = next_rank++;
+        up[x] = c.out[x];
+        down[x] = c.in[x];
+    }
+
+    flatten(up, ch->up_offsets, ch->up_targets, ch->up_weights,
+            ch->up_middle);
+    flatten(down, ch->down_offsets, ch->down_sources, ch->down_weights,
+            ch->down_middle);
+    return ch;
+}
+
+// Search state reused between queries of one thread; side 0 searches
+// upwards from the source, side 1 from the target
+struct ChWorkspace {
+    std::vector<uint64_t> dist[2];
+    std::vector<uint32_t> parent[2];
+    std::vector<uint32_t> middle[2];
+    std::vector<uint32_t> touched;
+};
+
+// Appends the vertices of edge a -> b after a, expanding shortcuts
+static void unpack(const ContractionHierarchy &ch, uint32_t a, uint32_t b,
+                   uint32_t middle, std::vector<uint32_t> &path) {
+    std::vector<PathEdge> stack(1, {a, b, middle});
+    while (!stack.empty()) {
+        PathEdge edge = stack.back();
+        stack.pop_back();
+        uint32_t m = edge.middle;
+        if (m == UINT32_MAX) {
+            path.push_back(edge.to);
+            continue;
+        }
+        // both halves were edges of m when it was contracted
+        uint32_t first = UINT32_MAX, second = UINT32_MAX;
+        uint32_t first_weight = UINT32_MAX, second_weight = UINT32_MAX;
+        for (uint64_t e = ch.down_offsets[m]; e < ch.down_offsets[m + 1];
+             e++) {
+            if (ch.down_sources[e] == edge.from &&
+                ch.down_weights[e] <= first_weight) {
+                first = ch.down_middle[e];
+                first_weight = ch.down_weights[e];
+            }
+        }
+        for (uint64_t e = ch.up_offsets[m]; e < ch.up_offsets[m + 1]; e++) {
+            if (ch.up_targets[e] == edge.to &&
+                ch.up_weights[e] <= second_weight) {
+                second = ch.up_middle[e];
+                second_weight = ch.up_weights[e];
+            }
+        }
+        stack.push_back({m, edge.to, second});
+        stack.push_back({edge.from, m, first});
+    }
+}
+
+uint64_t ch_query(const ContractionHierarchy &ch, uint32_t source,
+                  uint32_t target, std::vector<uint32_t> *path) {
+    if (path) path->clear();
+    uint32_t n = ch.n;
+    if (source >= n || target >= n || ch.rank[source] == UINT32_MAX ||
+        ch.rank[target] == UINT32_MAX)
+        return UNREACHABLE;
+
+    static thread_local ChWorkspace ws;
+    if (ws.dist[0].size() < n) {
+        for (int side = 0; side < 2; side++) {
+            ws.dist[side].resize(n, UNREACHABLE);
+            ws.parent[side].resize(n, UINT32_MAX);
+            ws.middle[side].resize(n, UINT32_MAX);
+        }
+    }
+    RadixHeap queue[2];
+    bool done[2] = {false, false};
+    uint32_t start[2] = {source, target};
+    for (int side = 0; side < 2; side++) {
+        ws.dist[side][start[side]] = 0;
+        ws.parent[side][start[side]] = UINT32_MAX;
+        ws.touched.push_back(start[side]);
+        queue[side].push(0, start[side]);
+    }
+
+    uint64_t best = UNREACHABLE;
+    uint32_t meet = UINT32_MAX;
+    while (!done[0] || !done[1]) {
+        for (int side = 0; side < 2; side++) {
+            if (done[side]) continue;
+            if (queue[side].size == 0) {
+                done[side] = true;
+                continue;
+            }
+            std::pair<uint64_t, uint32_t> top = queue[side].pop();
+            uint64_t d = top.first;
+            uint32_t v = top.second;
+            if (d != ws.dist[side][v]) continue;
+            if (d >= best) {
+                done[side] = true;
+                continue;
+            }
+            if (ws.dist[1 - side][v] != UNREACHABLE &&
+                d + ws.dist[1 - side][v] < best) {
+                best = d + ws.dist[1 - side][v];
+                meet = v;
+            }
+            const std::vector<uint64_t> &offsets =
+                side ? ch.down_offsets : ch.up_offsets;
+            const std::vector<uint32_t> &heads =
+                side ? ch.down_sources : ch.up_targets;
+            const std::vector<uint32_t> &weights =
+                side ? ch.down_weights : ch.up_weights;
+            const std::vector<uint32_t> &middle =
+                side ? ch.down_middle : ch.up_middle;
+            for (uint64_t e = offsets[v]; e < offsets[v + 1]; e++) {
+                uint32_t u = heads[e];
+                uint64_t candidate = d + weights[e];
+                if (candidate >= ws.dist[side][u]) continue;
+                ws.touched.push_back(u);
+                ws.dist[side][u] = candidate;
+                ws.parent[side][u] = v;
+                ws.middle[side][u] = middle[e];
+                queue[side].push(candidate, u);
+            }
+        }
+    }
+
+    if (path && best != UNREACHABLE) {
+        std::vector<PathEdge> edges;
+        for (uint32_t v = meet; v != source; v = ws.parent[0][v])
+            edges.push_back({ws.parent[0][v], v, ws.middle[0][v]});
+        std::reverse(edges.begin(), edges.end());
+        for (uint32_t v = meet; v != target; v = ws.parent[1][v])
+            edges.push_back({v, ws.parent[1][v], ws.middle[1][v]});
+        path->push_back(source);
+        for (const PathEdge &edge : edges)
+            unpack(ch, edge.from, edge.to, edge.middle, *path);
+    }
+    for (uint32_t v : ws.touched) {
+        ws.dist[0][v] = UNREACHABLE;
+        ws.dist[1][v] = UNREACHABLE;
+    }
+    ws.touched.clear();
+    return best;
+}
+
+std::string hierarchy_file(const std::string &filename) {
+    return filename + ".ch";
+}
+
+template <typename T>
+static void write_vector(std::ofstream &output, const std::vector<T> &v) {
+    uint64_t size = v.size();
+    output.write(reinterpret_cast<const char *>(&size), sizeof(size));
+    output.write(reinterpret_cast<const char *>(v.data()), size * sizeof(T));
+}
+
+template <typename T>
+static bool read_vector(std::ifstream &input, std::vector<T> &v) {
+    uint64_t size = 0;
+    input.read(reinterpret_cast<char *>(&size), sizeof(size));
+    if (!input) return false;
+    v.resize(size);
+    input.read(reinterpret_cast<char *>(v.data()), size * sizeof(T));
+    return static_cast<bool>(input);
+}
+
+int save_hierarchy(const ContractionHierarchy &ch, const Graph &graph,
+                   const std::string &filename) {
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open file " << filename << std::endl;
+        return 0;
+    }
+    uint64_t edges, weight;
+    graph_fingerprint(graph, edges, weight);
+    output.write(HIERARCHY_MAGIC, sizeof(HIERARCHY_MAGIC));
+    output.write(reinterpret_cast<const char *>(&edges), sizeof(edges));
+    output.write(reinterpret_cast<const char *>(&weight), sizeof(weight));
+    output.write(reinterpret_cast<const char *>(&ch.n), sizeof(ch.n));
+    output.write(reinterpret_cast<const char *>(&ch.shortcuts),
+                 sizeof(ch.shortcuts));
+    output.write(reinterpret_cast<const char *>(&ch.core), sizeof(ch.core));
+    write_vector(output, ch.rank);
+    write_vector(output, ch.up_offsets);
+    write_vector(output, ch.up_targets);
+    write_vector(output, ch.up_weights);
+    write_vector(output, ch.up_middle);
+    write_vector(output, ch.down_offsets);
+    write_vector(output, ch.down_sources);
+    write_vector(output, ch.down_weights);
+    write_vector(output, ch.down_middle);
+    return output.good() ? 1 : 0;
+}
+
+// Renames the vertices of one side of a hierarchy, `id` maps the saved IDs
+// to the new ones; returns false if an edge names a vertex without a new ID
+static bool remap_side(const std::vector<uint32_t> &id, uint32_t n,
+                       std::vector<uint64_t> &offsets,
+                       std::vector<uint32_t> &heads,
+                       std::vector<uint32_t> &weights,
+                       std::vector<uint32_t> &middle) {
+    std::vector<uint64_t> new_offsets(static_cast<size_t>(n) + 1, 0);
+    for (size_t v = 0; v < id.size(); v++) {
+        if (id[v] != UINT32_MAX)
+            new_offsets[id[v] + 1] = offsets[v + 1] - offsets[v];
+        else if (offsets[v + 1] != offsets[v])
+            return false;
+    }
+    for (uint32_t v = 0; v < n; v++) new_offsets[v + 1] += new_offsets[v];
+
+    std::vector<uint32_t> new_heads(heads.size()), new_weights(heads.size()),
+        new_middle(heads.size());
+    for (size_t v = 0; v < id.size(); v++) {
+        if (id[v] == UINT32_MAX) continue;
+        uint64_t at = new_offsets[id[v]];
+        for (uint64_t e = offsets[v]; e < offsets[v + 1]; e++, at++) {
+            if (heads[e] >= id.size() || id[heads[e]] == UINT32_MAX)
+                return false;
+            new_heads[at] = id[heads[e]];
+            new_weights[at] = weights[e];
+            if (middle[e] == UINT32_MAX) {
+                new_middle[at] = UINT32_MAX;
+            } else {
+                if (middle[e] >= id.size() || id[middle[e]] == UINT32_MAX)
+                    return false;
+                new_middle[at] = id[middle[e]];
+            }
+        }
+    }
+    offsets.swap(new_offsets);
+    heads.swap(new_heads);
+    weights.swap(new_weights);
+    middle.swap(new_middle);
+    return true;
+}
+
+std::shared_ptr<const ContractionHierarchy> load_hierarchy(
+    const Graph &graph, const std::string &filename) {
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open()) return nullptr;
+
+    char magic[sizeof(HIERARCHY_MAGIC)];
+    uint64_t edges, weight, expected_edges, expected_weight;
+    std::shared_ptr<ContractionHierarchy> ch =
+        std::make_shared<ContractionHierarchy>();
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char *>(&edges), sizeof(edges));
+    input.read(reinterpret_cast<char *>(&weight), sizeof(weight));
+    input.read(reinterpret_cast<char *>(&ch->n), sizeof(ch->n));
+    input.read(reinterpret_cast<char *>(&ch->shortcuts),
+               sizeof(ch->shortcuts));
+    input.read(reinterpret_cast<char *>(&ch->core), sizeof(ch->core));
+    graph_fingerprint(graph, expected_edges, expected_weight);
+    if (!input || std::memcmp(magic, HIERARCHY_MAGIC, sizeof(magic)) != 0 ||
+        edges != expected_edges || weight != expected_weight) {
+        std::cerr << "Ignoring " << filename
+                  << ", it belongs to a different graph\n";
+        return nullptr;
+    }
+    bool complete = read_vector(input, ch->rank) &&
+                    read_vector(input, ch->up_offsets) &&
+                    read_vector(input, ch->up_targets) &&
+                    read_vector(input, ch->up_weights) &&
+                    read_vector(input, ch->up_middle) &&
+                    read_vector(input, ch->down_offsets) &&
+                    read_vector(input, ch->down_sources) &&
+                    read_vector(input, ch->down_weights) &&
+                    read_vector(input, ch->down_middle);
+    if (!complete || ch->rank.size() != ch->n ||
+        ch->up_offsets.size() != static_cast<size_t>(ch->n) + 1 ||
+        ch->down_offsets.size() != static_cast<size_t>(ch->n) + 1) {
+        std::cerr << "Ignoring " << filename << ", it is truncated\n";
+        return nullptr;
+    }
+
+    // the file names vertices by the IDs of the graph file
+    const IdManager &manager = *graph.manager;
+    uint32_t n = manager.max_vertex;
+    std::vector<uint32_t> id(ch->n, UINT32_MAX);
+    for (const auto &entry : manager.map) {
+        if (entry.first < ch->n) id[entry.first] = entry.second;
+    }
+    std::vector<uint32_t> rank(n, UINT32_MAX);
+    for (uint32_t v = 0; v < ch->n; v++) {
+        if (id[v] != UINT32_MAX) rank[id[v]] = ch->rank[v];
+    }
+    if (!remap_side(id, n, ch->up_offsets, ch->up_targets, ch->up_weights,
+                    ch->up_middle) ||
+        !remap_side(id, n, ch->down_offsets, ch->down_sources,
+                    ch->down_weights, ch->down_middle)) {
+        std::cerr << "Ignoring " << filename
+                  << ", it names vertices missing from the graph\n";
+        return nullptr;
+    }
+    ch->rank.swap(rank);
+    ch->n = n;
+    std::cout << "Loaded a hierarchy with " << ch->shortcuts
+              << " shortcuts\n";
+    return ch;
+}
@@ -0,0 +1,128 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef HIERARCHY_H_
+#define HIERARCHY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Contraction hierarchy of a graph.
+ *
+ * Vertices are ranked by the order in which they were contracted. The upward
+ * graph holds, for every vertex, its edges and shortcuts towards vertices of
+ * higher rank; the downward graph holds, for every vertex, the edges and
+ * shortcuts reaching it from vertices of higher rank. Both are stored as CSR
+ * arrays. A shortcut records the vertex it bypasses in `middle`, UINT32_MAX
+ * for original edges. Distances must fit in 32 bits.
+ *
+ * Contraction stops early on graphs where it would add too many shortcuts.
+ * The highest-ranked `core` vertices are then left uncontracted and keep
+ * their edges to one another in both graphs, so queries fall back to a
+ * plain bidirectional search inside the core.
+ */
+struct ContractionHierarchy {
+    uint32_t n = 0;                     ///< Number of vertex IDs covered.
+    uint64_t shortcuts = 0;             ///< Number of shortcuts added.
+    uint32_t core = 0;                  ///< Vertices left uncontracted.
+    std::vector<uint32_t> rank;         ///< Contraction position per vertex.
+    std::vector<uint64_t> up_offsets;   ///< Start of each upward list.
+    std::vector<uint32_t> up_targets;   ///< Higher-ranked heads.
+    std::vector<uint32_t> up_weights;   ///< Weights of the upward edges.
+    std::vector<uint32_t> up_middle;    ///< Bypassed vertex of each edge.
+    std::vector<uint64_t> down_offsets; ///< Start of each downward list.
+    std::vector<uint32_t> down_sources; ///< Higher-ranked tails.
+    std::vector<uint32_t> down_weights; ///< Weights of the downward edges.
+    std::vector<uint32_t> down_middle;  ///< Bypassed vertex of each edge.
+};
+
+/**
+ * @brief Builds a contraction hierarchy.
+ *
+ * Every round contracts, in parallel, the vertices whose priority (edge
+ * difference, contracted neighbors and depth) is lower than that of all
+ * their neighbors; such vertices are independent, so their witness searches
+ * do not interfere as long as they avoid one another. The shortcuts are
+ * then merged and the priorities of the neighbors updated, also in
+ * parallel.
+ *
+ * @param csr The graph.
+ * @return std::shared_ptr<const ContractionHierarchy> The hierarchy.
+ */
+std::shared_ptr<const ContractionHierarchy> build_hierarchy(
+    const CsrGraph &csr);
+
+/**
+ * @brief Computes a shortest path with a bidirectional upward search.
+ *
+ * @param ch     The hierarchy.
+ * @param source The first vertex of the path.
+ * @param target The last vertex of the path.
+ * @param path   If not null, filled with the vertices of the path, with
+ * shortcuts unpacked.
+ * @return uint64_t Length of the path, UINT64_MAX if none exists.
+ */
+uint64_t ch_query(const ContractionHierarchy &ch, uint32_t source,
+                  uint32_t target, std::vector<uint32_t> *path = nullptr);
+
+/**
+ * @brief Returns the name of the hierarchy file kept next to a graph file.
+ * @param filename Name of the graph file.
+ * @return std::string The name of the hierarchy file.
+ */
+std::string hierarchy_file(const std::string &filename);
+
+/**
+ * @brief Writes a hierarchy to a binary file.
+ *
+ * @param ch       The hierarchy.
+ * @param graph    The graph the hierarchy belongs to.
+ * @param filename Name of the file to write.
+ * @return int 1 on success, 0 if the file could not be written.
+ */
+int save_hierarchy(const ContractionHierarchy &ch, const Graph &graph,
+                   const std::string &filename);
+
+/**
+ * @brief Reads a hierarchy saved next to a graph file.
+ *
+ * Vertices in the file are named by the IDs of the graph file, and are
+ * mapped through the graph's ID manager.
+ *
+ * @param graph    The graph loaded from the graph file.
+ * @param filename Name of the hierarchy file.
+ * @return std::shared_ptr<const ContractionHierarchy> The hierarchy, or
+ * null if the file does not exist or belongs to a different graph.
+ */
+std::shared_ptr<const ContractionHierarchy> load_hierarchy(
+    const Graph &graph, const std::string &filename);
+
+#endif  // HIERARCHY_H_
@@ -0,0 +1,129 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "HwCounters.h"
+
+// The counters of one thread: a group led by the first counter that
+// opened, read with a single system call
+struct ThreadCounters {
+    bool tried = false;
+    int leader = -1;
+    int fds[HW_COUNTER_COUNT];
+    uint32_t members = 0;             // counters in the group
+    uint32_t order[HW_COUNTER_COUNT];  // counter of each group member
+    uint32_t available = 0;
+
+    ~ThreadCounters();
+};
+
+static const char *const counter_names[HW_COUNTER_COUNT] = {
+    "cycles", "instructions", "llc_misses", "branch_misses"};
+
+static std::atomic<bool> counting(false);
+static thread_local ThreadCounters counters;
+
+ThreadCounters::~ThreadCounters() {
+#if defined(__linux__)
+    for (uint32_t i = 0; i < members; i++) close(fds[i]);
+#endif
+}
+
+static void open_counters(ThreadCounters &state) {
+    state.tried = true;
+#if defined(__linux__) && defined(SYS_perf_event_open)
+    static const uint64_t configs[HW_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[c];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, state.leader, 0));
+        if (fd < 0) continue;
+        if (state.leader < 0) state.leader = fd;
+        state.fds[state.members] = fd;
+        state.order[state.members++] = c;
+        state.available |= 1u << c;
+    }
+#endif
+}
+
+bool set_hw_counters_enabled(bool enabled) {
+    counting.store(enabled && hw_counters_available() != 0);
+    return counting.load();
+}
+
+bool hw_counters_enabled() {
+    return counting.load(std::memory_order_relaxed);
+}
+
+uint32_t hw_counters_available() {
+    if (!counters.tried) open_counters(counters);
+    return counters.available;
+}
+
+bool hw_counters_read(HwSample &sample) {
+    sample = HwSample();
+    if (hw_counters_available() == 0) return false;
+#if defined(__linux__)
+    // number of members, time enabled, time running, then the values
+    uint64_t data[3 + HW_COUNTER_COUNT];
+    ssize_t size = read(counters.leader, data, sizeof(data));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) || data[2] == 0)
+        return false;
+    double scale = static_cast<double>(data[1]) / data[2];
+    for (uint32_t i = 0; i < data[0] && i < counters.members; i++) {
+        uint32_t c = counters.order[i];
+        sample.values[c] = data[1] == data[2]
+                               ? data[3 + i]
+                               : static_cast<uint64_t>(data[3 + i] * scale);
+        sample.valid |= 1u << c;
+    }
+    return sample.valid != 0;
+#else
+    return false;
+#endif
+}
+
+const char *hw_counter_name(uint32_t counter) {
+    return counter < HW_COUNTER_COUNT ? counter_names[counter] : "unknown";
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef HWCOUNTERS_H_
+#define HWCOUNTERS_H_
+
+#include <cstdint>
+
+// Hardware performance counters through perf_event_open. Every thread that
+// reads them opens its own group of counters, which only counts that
+// thread, in user space. Counters the CPU, the kernel or a virtual machine
+// do not provide are left out, and without any counter the reads fail and
+// callers go on without them.
+
+#define HW_CYCLES 0
+#define HW_INSTRUCTIONS 1
+#define HW_LLC_MISSES 2
+#define HW_BRANCH_MISSES 3
+#define HW_COUNTER_COUNT 4
+
+/**
+ * @brief Values of the counters of one thread, or the difference of two
+ * readings.
+ */
+struct HwSample {
+    uint64_t values[HW_COUNTER_COUNT] = {0};  ///< Indexed by HW_ constants.
+    uint32_t valid = 0;  ///< Bit c is set if counter c was read.
+};
+
+/**
+ * @brief Turns counting for the operation metrics on or off; it is off by
+ * default, as every reading costs a system call.
+ * @param enabled Whether counting is wanted.
+ * @return bool Whether counting is now on, which needs at least one counter
+ * on the calling thread.
+ */
+bool set_hw_counters_enabled(bool enabled);
+
+/**
+ * @brief Tells whether counting is on.
+ * @return bool True if counting is on.
+ */
+bool hw_counters_enabled();
+
+/**
+ * @brief Tells which counters the calling thread can read, opening them on
+ * first use.
+ * @return uint32_t Bit c is set if counter c is available.
+ */
+uint32_t hw_counters_available();
+
+/**
+ * @brief Reads the counters of the calling thread, opening them on first
+ * use.
+ *
+ * Counters the kernel had to multiplex are scaled up to the whole time they
+ * were enabled.
+ * @param sample Set to the values.
+ * @return bool Whether any counter was read.
+ */
+bool hw_counters_read(HwSample &sample);
+
+/**
+ * @brief Returns the name of a counter.
+ * @param counter One of the HW_ constants.
+ * @return const char* The name, as used in the metrics output.
+ */
+const char *hw_counter_name(uint32_t counter);
+
+#endif  // HWCOUNTERS_H_
@@ -3,7 +3,8 @@
 #include "IdManager.h"
 
 uint32_t get_id(IdManager &manager, uint32_t vertex) {
-    if (manager.map.find(vertex) == manager.map.end()) {
+    auto pos = manager.map.find(vertex);
+    if (pos == manager.map.end()) {
         if (manager.unused_ids.size() == 0) {
             manager.map[vertex] = manager.max_vertex;
             manager.max_vertex++;
@@ -14,7 +15,7 @@ uint32_t get_id(IdManager &manager, uint32_t vertex) {
         manager.unused_ids.pop_back();
         return id;
     }
-    return manager.map[vertex];
+    return pos->second;
 }
 
 uint32_t generate_id(IdManager &manager) {
@@ -35,6 +36,6 @@ void remove_id(IdManager &manager, uint32_t vertex) {
         return;
     }
 
-    manager.unused_ids.push_back(manager.map[vertex]);
-    manager.map.erase(pos);
+    manager.unused_ids.push_back(pos->second);
+    manager.map.erase(vertex);
 }
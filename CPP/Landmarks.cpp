@@ -0,0 +1,323 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Csr.h"
+#include "GraphStore.h"
+#include "Landmarks.h"
+#include "Parallel.h"
+#include "ShortestPath.h"
+#include "Structures.h"
+
+static const char LANDMARK_MAGIC[4] = {'A', 'L', 'T', '1'};
+
+static inline uint32_t clamp_distance(uint64_t d) {
+    return d >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(d);
+}
+
+std::shared_ptr<const LandmarkTable> build_landmarks(const CsrGraph &csr,
+                                                     uint32_t k) {
+    std::shared_ptr<LandmarkTable> table = std::make_shared<LandmarkTable>();
+    uint32_t n = csr.n, present = 0, start = UINT32_MAX;
+    uint64_t best_degree = 0;
+    for (uint32_t v = 0; v < n; v++) {
+        if (!csr.present[v]) continue;
+        present++;
+        uint64_t degree = csr.out_offsets[v + 1] - csr.out_offsets[v] +
+                          csr.in_offsets[v + 1] - csr.in_offsets[v];
+        if (start == UINT32_MAX || degree > best_degree) {
+            start = v;
+            best_degree = degree;
+        }
+    }
+    k = std::min(k, present);
+    table->n = n;
+    table->k = k;
+    table->from.assign(static_cast<size_t>(n) * k, UINT32_MAX);
+    table->to.assign(static_cast<size_t>(n) * k, UINT32_MAX);
+    if (k == 0) return table;
+
+    // the first landmark is the vertex farthest from a central one
+    std::vector<uint64_t> dist = dijkstra(csr, start);
+    uint32_t next = start;
+    for (uint32_t v = 0; v < n; v++) {
+        if (dist[v] != UNREACHABLE && dist[v] > dist[next]) next = v;
+    }
+
+    std::shared_ptr<const CsrGraph> reversed = reverse_csr(csr);
+    // distance of every vertex to the closest landmark, both ways summed;
+    // UNREACHABLE while no landmark is connected to it
+    std::vector<uint64_t> score(n, UNREACHABLE);
+    std::vector<uint64_t> forward, backward;
+    for (uint32_t i = 0; i < k; i++) {
+        uint32_t landmark = next;
+        table->landmarks.push_back(landmark);
+        parallel_for(
+            0, 2,
+            [&](size_t from, size_t to) {
+                for (size_t side = from; side < to; side++) {
+                    if (side == 0)
+                        forward = dijkstra(csr, landmark);
+                    else
+                        backward = dijkstra(*reversed, landmark);
+                }
+            },
+            1);
+
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            for (size_t v = from; v < to; v++) {
+                table->from[v * k + i] = clamp_distance(forward[v]);
+                table->to[v * k + i] = clamp_distance(backward[v]);
+                if (forward[v] == UNREACHABLE && backward[v] == UNREACHABLE)
+                    continue;
+                uint64_t sum = (forward[v] == UNREACHABLE ? 0 : forward[v]) +
+                               (backward[v] == UNREACHABLE ? 0 : backward[v]);
+                score[v] = std::min(score[v], sum);
+            }
+        });
+
+        next = UINT32_MAX;
+        for (uint32_t v = 0; v < n; v++) {
+            if (!csr.present[v] || score[v] == 0) continue;
+            if (next == UINT32_MAX || score[v] > score[next]) next = v;
+        }
+        if (next == UINT32_MAX) {
+            // every vertex is a landmark already
+            table->k = i + 1;
+            break;
+        }
+    }
+
+    if (table->k < k) {
+        // drop the columns of the landmarks that were not needed
+        uint32_t used = table->k;
+        std::vector<uint32_t> from(static_cast<size_t>(n) * used),
+            to(static_cast<size_t>(n) * used);
+        for (size_t v = 0; v < n; v++) {
+            std::copy_n(&table->from[v * k], used, &from[v * used]);
+            std::copy_n(&table->to[v * k], used, &to[v * used]);
+        }
+        table->from.swap(from);
+        table->to.swap(to);
+    }
+    return table;
+}
+
+// Search state reused between queries of one thread, so a query only pays
+// for the vertices it touches
+struct AltWorkspace {
+    std::vector<uint64_t> dist;
+    std::vector<uint64_t> key;  // key of the latest queue entry
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> touched;
+};
+
+uint64_t alt_query(const CsrGraph &csr, const LandmarkTable &table,
+                   uint32_t source, uint32_t target,
+                   std::vector<uint32_t> *path, uint64_t *settled) {
+    if (path) path->clear();
+    if (settled) *settled = 0;
+    uint32_t n = csr.n, k = table.k;
+    if (source >= n || target >= n || !csr.present[source] ||
+        !csr.present[target])
+        return UNREACHABLE;
+
+    // lower bound on d(v, target) from landmark i, 0 when the table has no
+    // information
+    auto bound = [&](uint32_t v, uint32_t i) -> uint64_t {
+        if (v >= table.n || target >= table.n) return 0;
+        size_t at_v = static_cast<size_t>(v) * k + i;
+        size_t at_t = static_cast<size_t>(target) * k + i;
+        uint32_t vl = table.to[at_v], tl = table.to[at_t];
+        uint32_t lt = table.from[at_t], lv = table.from[at_v];
+        uint64_t best = 0;
+        if (vl != UINT32_MAX && tl != UINT32_MAX && vl > tl) best = vl - tl;
+        if (lt != UINT32_MAX && lv != UINT32_MAX && lt > lv)
+            best = std::max<uint64_t>(best, lt - lv);
+        return best;
+    };
+    // the landmarks giving the best bounds at the source are used for the
+    // whole query
+    uint32_t active[ALT_ACTIVE];
+    uint32_t used = 0;
+    if (target < table.n) {
+        std::vector<uint32_t> order(k);
+        for (uint32_t i = 0; i < k; i++) order[i] = i;
+        used = std::min<uint32_t>(k, ALT_ACTIVE);
+        std::partial_sort(order.begin(), order.begin() + used, order.end(),
+                          [&](uint32_t a, uint32_t b) {
+                              return bound(source, a) > bound(source, b);
+                          });
+        std::copy_n(order.begin(), used, active);
+    }
+    auto potential = [&](uint32_t v) {
+        uint64_t best = 0;
+        for (uint32_t j = 0; j < used; j++)
+            best = std::max(best, bound(v, active[j]));
+        return best;
+    };
+
+    static thread_local AltWorkspace ws;
+    if (ws.dist.size() < n) {
+        ws.dist.resize(n, UNREACHABLE);
+        ws.key.resize(n);
+        ws.parent.resize(n, UINT32_MAX);
+    }
+    RadixHeap queue;
+    ws.dist[source] = 0;
+    ws.key[source] = potential(source);
+    ws.parent[source] = UINT32_MAX;
+    ws.touched.push_back(source);
+    queue.push(ws.key[source], source);
+
+    uint64_t result = UNREACHABLE;
+    while (queue.size) {
+        std::pair<uint64_t, uint32_t> top = queue.pop();
+        uint32_t v = top.second;
+        if (top.first != ws.key[v]) continue;
+        if (settled) (*settled)++;
+        if (v == target) {
+            result = ws.dist[v];
+            break;
+        }
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            uint64_t candidate = ws.dist[v] + csr.out_weights[e];
+            if (candidate >= ws.dist[u]) continue;
+            if (ws.dist[u] == UNREACHABLE) ws.touched.push_back(u);
+            ws.dist[u] = candidate;
+            ws.parent[u] = v;
+            // raising the key to the parent's (pathmax) keeps it a lower
+            // bound and the keys monotone even if the bounds are stale
+            ws.key[u] = std::max(top.first, candidate + potential(u));
+            queue.push(ws.key[u], u);
+        }
+    }
+
+    if (path && result != UNREACHABLE) {
+        for (uint32_t v = target; v != UINT32_MAX; v = ws.parent[v])
+            path->push_back(v);
+        std::reverse(path->begin(), path->end());
+    }
+    for (uint32_t v : ws.touched) ws.dist[v] = UNREACHABLE;
+    ws.touched.clear();
+    return result;
+}
+
+std::string landmark_file(const std::string &filename) {
+    return filename + ".alt";
+}
+
+int save_landmarks(const LandmarkTable &table, const Graph &graph,
+                   const std::string &filename) {
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open file " << filename << std::endl;
+        return 0;
+    }
+    uint64_t edges, weight;
+    graph_fingerprint(graph, edges, weight);
+    output.write(LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC));
+    output.write(reinterpret_cast<const char *>(&table.n), sizeof(table.n));
+    output.write(reinterpret_cast<const char *>(&table.k), sizeof(table.k));
+    output.write(reinterpret_cast<const char *>(&edges), sizeof(edges));
+    output.write(reinterpret_cast<const char *>(&weight), sizeof(weight));
+    output.write(reinterpret_cast<const char *>(table.landmarks.data()),
+                 table.landmarks.size() * sizeof(uint32_t));
+    output.write(reinterpret_cast<const char *>(table.from.data()),
+                 table.from.size() * sizeof(uint32_t));
+    output.write(reinterpret_cast<const char *>(table.to.data()),
+                 table.to.size() * sizeof(uint32_t));
+    return output.good() ? 1 : 0;
+}
+
+std::shared_ptr<const LandmarkTable> load_landmarks(
+    const Graph &graph, const std::string &filename) {
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open()) return nullptr;
+
+    char magic[sizeof(LANDMARK_MAGIC)];
+    LandmarkTable saved;
+    uint64_t edges, weight, expected_edges, expected_weight;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char *>(&saved.n), sizeof(saved.n));
+    input.read(reinterpret_cast<char *>(&saved.k), sizeof(saved.k));
+    input.read(reinterpret_cast<char *>(&edges), sizeof(edges));
+    input.read(reinterpret_cast<char *>(&weight), sizeof(weight));
+    graph_fingerprint(graph, expected_edges, expected_weight);
+    if (!input || std::memcmp(magic, LANDMARK_MAGIC, sizeof(magic)) != 0 ||
+        edges != expected_edges || weight != expected_weight) {
+        std::cerr << "Ignoring " << filename
+                  << ", it belongs to a different graph\n";
+        return nullptr;
+    }
+    size_t cells = static_cast<size_t>(saved.n) * saved.k;
+    saved.landmarks.resize(saved.k);
+    saved.from.resize(cells);
+    saved.to.resize(cells);
+    input.read(reinterpret_cast<char *>(saved.landmarks.data()),
+               saved.k * sizeof(uint32_t));
+    input.read(reinterpret_cast<char *>(saved.from.data()),
+               cells * sizeof(uint32_t));
+    input.read(reinterpret_cast<char *>(saved.to.data()),
+               cells * sizeof(uint32_t));
+    if (!input) {
+        std::cerr << "Ignoring " << filename << ", it is truncated\n";
+        return nullptr;
+    }
+
+    // the file names vertices by the IDs of the graph file
+    const IdManager &manager = *graph.manager;
+    std::shared_ptr<LandmarkTable> table = std::make_shared<LandmarkTable>();
+    uint32_t k = saved.k;
+    table->n = manager.max_vertex;
+    table->k = k;
+    table->from.assign(static_cast<size_t>(table->n) * k, UINT32_MAX);
+    table->to.assign(static_cast<size_t>(table->n) * k, UINT32_MAX);
+    for (const auto &entry : manager.map) {
+        uint32_t file_id = entry.first, id = entry.second;
+        if (file_id >= saved.n || id >= table->n) continue;
+        std::copy_n(&saved.from[static_cast<size_t>(file_id) * k], k,
+                    &table->from[static_cast<size_t>(id) * k]);
+        std::copy_n(&saved.to[static_cast<size_t>(file_id) * k], k,
+                    &table->to[static_cast<size_t>(id) * k]);
+    }
+    for (uint32_t landmark : saved.landmarks) {
+        auto it = manager.map.find(landmark);
+        table->landmarks.push_back(it == manager.map.end() ? UINT32_MAX
+                                                           : it->second);
+    }
+    std::cout << "Loaded " << k << " landmarks\n";
+    return table;
+}
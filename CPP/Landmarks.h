@@ -0,0 +1,129 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef LANDMARKS_H_
+#define LANDMARKS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/// Number of landmarks used by a single query.
+#define ALT_ACTIVE 4
+
+/**
+ * @brief Distances between every vertex and a set of landmark vertices.
+ *
+ * Distances are stored per vertex, `k` consecutive entries each, so a query
+ * reads one cache line per vertex. UINT32_MAX stands for "no path" as well
+ * as for distances too long to store; either way the entry gives no bound.
+ */
+struct LandmarkTable {
+    uint32_t n = 0;                   ///< Number of vertex IDs covered.
+    uint32_t k = 0;                   ///< Number of landmarks.
+    std::vector<uint32_t> landmarks;  ///< The landmark vertices.
+    std::vector<uint32_t> from;  ///< `from[v * k + i]`: landmark i to v.
+    std::vector<uint32_t> to;    ///< `to[v * k + i]`: v to landmark i.
+};
+
+/**
+ * @brief Selects landmarks and computes their distance table.
+ *
+ * Landmarks are picked by farthest selection: each new landmark is the
+ * vertex farthest from the ones chosen so far, and vertices that none of
+ * them reaches are picked first. Each landmark costs a forward and a
+ * backward Dijkstra search, run in parallel.
+ *
+ * @param csr The graph.
+ * @param k   Number of landmarks.
+ * @return std::shared_ptr<const LandmarkTable> The table.
+ */
+std::shared_ptr<const LandmarkTable> build_landmarks(const CsrGraph &csr,
+                                                     uint32_t k);
+
+/**
+ * @brief Computes a shortest path with A* guided by landmark bounds.
+ *
+ * By the triangle inequality, d(v, t) >= d(v, L) - d(t, L) and
+ * d(v, t) >= d(L, t) - d(L, v) for every landmark L; the largest of these
+ * bounds over the ALT_ACTIVE landmarks best suited to the query is the A*
+ * potential. Vertices may be reopened, so the result stays exact even when
+ * the table is older than the graph, as long as no distance became
+ * shorter since it was built.
+ *
+ * @param csr     The graph.
+ * @param table   The landmark table.
+ * @param source  The first vertex of the path.
+ * @param target  The last vertex of the path.
+ * @param path    If not null, filled with the vertices of the path.
+ * @param settled If not null, set to the number of vertices taken from the
+ * queue.
+ * @return uint64_t Length of the path, UINT64_MAX if none exists.
+ */
+uint64_t alt_query(const CsrGraph &csr, const LandmarkTable &table,
+                   uint32_t source, uint32_t target,
+                   std::vector<uint32_t> *path = nullptr,
+                   uint64_t *settled = nullptr);
+
+/**
+ * @brief Returns the name of the landmark file kept next to a graph file.
+ * @param filename Name of the graph file.
+ * @return std::string The name of the landmark file.
+ */
+std::string landmark_file(const std::string &filename);
+
+/**
+ * @brief Writes a landmark table to a binary file.
+ *
+ * The file records the number of edges and their total weight, which
+ * load_landmarks() checks to reject tables of a different graph.
+ *
+ * @param table    The table.
+ * @param graph    The graph the table belongs to.
+ * @param filename Name of the file to write.
+ * @return int 1 on success, 0 if the file could not be written.
+ */
+int save_landmarks(const LandmarkTable &table, const Graph &graph,
+                   const std::string &filename);
+
+/**
+ * @brief Reads a landmark table saved next to a graph file.
+ *
+ * Vertices in the file are named by the IDs of the graph file, and are
+ * mapped through the graph's ID manager.
+ *
+ * @param graph    The graph loaded from the graph file.
+ * @param filename Name of the landmark file.
+ * @return std::shared_ptr<const LandmarkTable> The table, or null if the
+ * file does not exist or belongs to a different graph.
+ */
+std::shared_ptr<const LandmarkTable> load_landmarks(
+    const Graph &graph, const std::string &filename);
+
+#endif  // LANDMARKS_H_
@@ -0,0 +1,329 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LAYEREDMAP_H_
+#define LAYEREDMAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+/**
+ * @brief Value policy of a LayeredMap whose values are plain copies.
+ */
+struct CopyValues {
+    /**
+     * @brief Returns the value a layer stores when it takes over an entry of
+     * a layer below.
+     * @param value The value below.
+     * @return V The same value.
+     */
+    template <class V>
+    static V share(const V &value) {
+        return value;
+    }
+
+    /**
+     * @brief Drops a value overwritten while layers are folded.
+     * @param value The value.
+     */
+    template <class V>
+    static void release(const V &) {}
+};
+
+/**
+ * @brief A hash map that can be stacked on a shared, read-only map.
+ *
+ * A map without a base is an ordinary hash map. A map built over a base only
+ * stores the entries set in it and tombstones for the keys erased in it;
+ * lookups fall through to the base for every other key. Forks of a graph
+ * each stack a map on the tables they share, so the first change of a fork
+ * costs as much as the entries it touches.
+ *
+ * Entries are read through find() and the iterators, which never modify the
+ * map, and written through operator[], emplace() and erase(). Writing an
+ * entry of the base first copies it into the top map with
+ * `Values::share()`.
+ *
+ * @tparam Key    Key type.
+ * @tparam Value  Value type.
+ * @tparam Hash   Hash function of the keys.
+ * @tparam Values How values are shared between layers, see CopyValues.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>,
+          class Values = CopyValues>
+struct LayeredMap {
+    typedef std::unordered_map<Key, Value, Hash> Table;
+    typedef typename Table::value_type value_type;
+
+    Table local;                            ///< Entries set in this map.
+    std::unordered_set<Key, Hash> erased;   ///< Keys of the base erased here.
+    std::shared_ptr<const LayeredMap> base;  ///< Map below, null if none.
+    size_t entries = 0;  ///< Number of entries while there is a base.
+
+    /**
+     * @brief Iterates over the visible entries, skipping the ones of lower
+     * maps that a higher one sets or erases.
+     */
+    struct const_iterator {
+        const LayeredMap *top = nullptr;    ///< The map iterated over.
+        const LayeredMap *layer = nullptr;  ///< Map of the entry, null at end.
+        typename Table::const_iterator it;  ///< The entry in `layer`.
+
+        const value_type &operator*() const { return *it; }
+        const value_type *operator->() const { return &*it; }
+
+        const_iterator &operator++() {
+            ++it;
+            settle();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator before = *this;
+            ++*this;
+            return before;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return layer == other.layer && (layer == nullptr || it == other.it);
+        }
+        bool operator!=(const const_iterator &other) const {
+            return !(*this == other);
+        }
+
+        /// Moves forward to the next visible entry.
+        void settle() {
+            while (layer != nullptr) {
+                if (it == layer->local.end()) {
+                    layer = layer->base.get();
+                    if (layer != nullptr) it = layer->local.begin();
+                    continue;
+                }
+                if (layer == top || !top->shadows(layer, it->first)) return;
+                ++it;
+            }
+        }
+    };
+    typedef const_iterator iterator;
+
+    LayeredMap() = default;
+
+    /**
+     * @brief Builds an empty map over a base, holding the same entries.
+     * @param below The base, which must no longer be modified.
+     */
+    explicit LayeredMap(std::shared_ptr<const LayeredMap> below)
+        : base(std::move(below)), entries(base->size()) {}
+
+    LayeredMap(const LayeredMap &) = delete;
+    LayeredMap &operator=(const LayeredMap &) = delete;
+
+    const_iterator begin() const {
+        const_iterator first;
+        first.top = this;
+        first.layer = this;
+        first.it = local.begin();
+        first.settle();
+        return first;
+    }
+
+    const_iterator end() const {
+        const_iterator last;
+        last.top = this;
+        return last;
+    }
+
+    const_iterator find(const Key &key) const {
+        const_iterator found;
+        found.top = this;
+        const LayeredMap *layer = this;
+        while (true) {
+            found.it = layer->local.find(key);
+            if (found.it != layer->local.end()) {
+                found.layer = layer;
+                return found;
+            }
+            if (!layer->base || layer->erased.count(key)) return found;
+            layer = layer->base.get();
+        }
+    }
+
+    size_t count(const Key &key) const { return find(key) != end(); }
+
+    size_t size() const { return base ? entries : local.size(); }
+
+    bool empty() const { return size() == 0; }
+
+    void reserve(size_t n) { local.reserve(n); }
+
+    /**
+     * @brief Returns the value of a key to be modified, copying it from the
+     * base first and adding it if the key is not set.
+     * @param key The key.
+     * @return Value& The value, stored in this map.
+     */
+    Value &operator[](const Key &key) {
+        if (!base) return local[key];
+        auto it = local.find(key);
+        if (it != local.end()) return it->second;
+        const_iterator below = below_find(key);
+        if (below != end())
+            return local.emplace(key, Values::share(below->second))
+                .first->second;
+        erased.erase(key);
+        entries++;
+        return local[key];
+    }
+
+    /**
+     * @brief Adds an entry unless the key is already set.
+     * @param key   The key.
+     * @param value The value.
+     * @return std::pair<const_iterator, bool> The entry of the key, and
+     * whether it was added.
+     */
+    std::pair<const_iterator, bool> emplace(const Key &key,
+                                            const Value &value) {
+        if (base) {
+            const_iterator found = find(key);
+            if (found != end()) return {found, false};
+            erased.erase(key);
+            entries++;
+        }
+        auto placed = local.emplace(key, value);
+        const_iterator it;
+        it.top = this;
+        it.layer = this;
+        it.it = placed.first;
+        return {it, placed.second};
+    }
+
+    /**
+     * @brief Erases an entry. Its value is not released.
+     * @param key The key.
+     * @return size_t 1 if the entry existed, 0 otherwise.
+     */
+    size_t erase(const Key &key) {
+        if (!base) return local.erase(key);
+        bool set_here = local.erase(key) != 0;
+        bool set_below = below_find(key) != end();
+        if (!set_here && !set_below) return 0;
+        if (set_below) erased.insert(key);
+        entries--;
+        return 1;
+    }
+
+    void clear() {
+        local.clear();
+        erased.clear();
+        base.reset();
+        entries = 0;
+    }
+
+    /**
+     * @brief Copies the entries of the maps below into this one, leaving it
+     * without a base.
+     * @return Table& The table now holding every entry, free to modify.
+     */
+    Table &flat() {
+        if (!base) return local;
+        Table table;
+        table.reserve(size());
+        for (const value_type &entry : *this)
+            table.emplace(entry.first, Values::share(entry.second));
+        for (const value_type &entry : local) Values::release(entry.second);
+        local.swap(table);
+        clear_layers();
+        return local;
+    }
+
+    /**
+     * @brief Merges this map into its base for as long as no other map
+     * uses the base, so maps stacked on forks that are gone cost nothing.
+     *
+     * Takes time proportional to the entries set and erased in this map.
+     */
+    void fold() {
+        while (base && base.use_count() == 1) {
+            // the base is only reachable through this map
+            LayeredMap &below = const_cast<LayeredMap &>(*base);
+            for (const Key &key : erased) {
+                auto it = below.local.find(key);
+                if (it != below.local.end()) {
+                    Values::release(it->second);
+                    below.local.erase(it);
+                }
+                if (below.base) below.erased.insert(key);
+            }
+            for (const value_type &entry : local) {
+                auto it = below.local.find(entry.first);
+                if (it == below.local.end()) {
+                    below.local.emplace(entry.first, entry.second);
+                } else {
+                    Values::release(it->second);
+                    it->second = entry.second;
+                }
+            }
+            local.clear();
+            erased.clear();
+            local.swap(below.local);
+            erased.swap(below.erased);
+            std::shared_ptr<const LayeredMap> deeper = below.base;
+            base = std::move(deeper);
+        }
+        if (!base) clear_layers();
+    }
+
+  private:
+    // Whether a map above `layer` sets or erases the key
+    bool shadows(const LayeredMap *layer, const Key &key) const {
+        for (const LayeredMap *above = this; above != layer;
+             above = above->base.get()) {
+            if (above->local.count(key) || above->erased.count(key))
+                return true;
+        }
+        return false;
+    }
+
+    // Entry of the key in the maps below, unless erased here
+    const_iterator below_find(const Key &key) const {
+        if (erased.count(key)) return end();
+        const_iterator found = base->find(key);
+        if (found == base->end()) return end();
+        found.top = this;
+        return found;
+    }
+
+    void clear_layers() {
+        erased.clear();
+        base.reset();
+        entries = 0;
+    }
+};
+
+#endif  // LAYEREDMAP_H_
@@ -22,7 +22,7 @@
 // ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/types.h>
 
-#include <chrono>
+#include <atomic>
 #include <csignal>
 #include <cstdint>
 #include <cstdio>
@@ -33,8 +33,11 @@
 #include <ostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Data.h"
+#include "GraphStore.h"
+#include "Numa.h"
 #include "Structures.h"
 #include "UiRead.h"
 
@@ -54,22 +57,52 @@ void print_menu() {
 10. Add edges                         \n\
 11. Remove edges                      \n\
 12. Save a copy                       \n\
-13. Open a Graph                      \n\
+13. Open a Graph (in background)      \n\
 14. Parse vertices                    \n\
 15. Parse outbound                    \n\
 16. Parse inbound                     \n\
+17. Apply a delta file                \n\
+18. Fork the graph                    \n\
+19. Discard the fork                  \n\
+20. Hop distances from a vertex       \n\
+21. Weighted distances from a vertex  \n\
+22. Shortest path between vertices    \n\
+23. Strongly connected components     \n\
+24. PageRank of vertices              \n\
+25. Topological levels and cycles     \n\
+26. Hop distances from many sources   \n\
+27. Select landmarks for path queries \n\
+28. Build a contraction hierarchy     \n\
+29. Betweenness centrality            \n\
+30. Maximum flow and minimum cut      \n\
+31. Random walks to a file            \n\
+32. Triangles and clustering          \n\
+33. Approximate neighborhood sizes    \n\
+34. Connectivity of vertex pairs      \n\
+35. Reorder vertices for locality     \n\
+36. Scheduler utilization             \n\
+37. Generate a graph in memory        \n\
+38. Operation metrics                 \n\
 --------------------------------------\n\
 0.  Exit\n\
 --------------------------------------\n";
     std::cout << Menu;
 }
 
-int choose_option(std::unordered_map<uint32_t, uint32_t *> &inbound,
-                  std::unordered_map<uint32_t, uint32_t *> &outbound,
-                  std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                                     pair_hash> &costs,
-                  IdManager &manager, uint32_t &Vertices, uint32_t &Edges,
-                  uint32_t vertex_buffer, char *filename) {
+// Options that modify the graph, and so must not touch tables shared with
+// a fork or keep views built from its old contents
+int is_mutation(int option) {
+    return (option >= 7 && option <= 11) || option == 17 || option == 35;
+}
+
+// Mutations after which no distance in the graph can become shorter
+int only_lengthens(int option) {
+    return option == 8 || option == 9 || option == 11;
+}
+
+int choose_option(std::atomic<Graph *> &current, GraphReloader &reloader,
+                  std::vector<Graph *> &parents, uint32_t vertex_buffer,
+                  char *filename) {
     int option = 0;
     std::string soption;
     while (!option) {
@@ -82,71 +115,183 @@ int choose_option(std::unordered_map<uint32_t, uint32_t *> &inbound,
         }
     }
 
+    // a reload may have finished while waiting for input
+    poll_reload(reloader, current, parents);
+    Graph &graph = *current.load();
+    if (is_mutation(option)) begin_mutation(graph, only_lengthens(option));
+    AdjacencyMap &inbound = *graph.inbound;
+    AdjacencyMap &outbound = *graph.outbound;
+    CostMap &costs = *graph.costs;
+    IdManager &manager = *graph.manager;
+    const IdTranslation *ids = graph.ids.get();
+    uint32_t &Vertices = graph.vertices;
+    uint32_t &Edges = graph.edges;
+
     switch (option) {
         case 1:
             std::cout << Vertices << "\n";
             break;
 
         case 2: {
-            opt2(outbound);
+            opt2(outbound, ids);
             break;
         }
 
         case 3: {
-            opt3(outbound, inbound);
+            opt3(outbound, inbound, ids);
             break;
         }
 
         case 4: {
-            opt4(outbound);
+            opt4(outbound, ids);
             break;
         }
         case 5: {
-            opt5(inbound);
+            opt5(inbound, ids);
             break;
         }
         case 6: {
-            opt6(outbound, costs);
+            opt6(outbound, costs, ids);
             break;
         }
         case 7: {
-            opt7(outbound, costs);
+            opt7(outbound, costs, ids);
             break;
         }
         case 8: {
-            opt8(outbound, inbound, manager, vertex_buffer, Vertices);
+            opt8(outbound, inbound, manager, vertex_buffer, Vertices,
+                 graph.connectivity.get(), ids);
             break;
         }
         case 9: {
-            opt9(outbound, inbound, costs, manager, Vertices);
+            opt9(outbound, inbound, costs, manager, Vertices,
+                 graph.connectivity.get(), ids);
             break;
         }
         case 10: {
-            opt10(vertex_buffer, Edges, outbound, inbound, costs);
+            opt10(vertex_buffer, Edges, outbound, inbound, costs,
+                  graph.connectivity.get(), ids);
             break;
         }
         case 11: {
-            opt11(vertex_buffer, Edges, outbound, inbound, costs);
+            opt11(vertex_buffer, Edges, outbound, inbound, costs,
+                  graph.connectivity.get(), ids);
             break;
         }
         case 12: {
-            save(costs, Vertices, Edges);
+            save(graph);
             break;
         }
         case 13: {
-            return import(inbound, outbound, costs, Vertices, Edges,
-                          vertex_buffer, manager, filename);
+            return import(reloader, vertex_buffer, filename);
         }
         case 14: {
-            opt14(outbound);
+            opt14(outbound, ids);
             break;
         }
         case 15: {
-            opt15(outbound);
+            opt15(outbound, ids);
             break;
         }
         case 16: {
-            opt16(inbound);
+            opt16(inbound, ids);
+            break;
+        }
+        case 17: {
+            opt17(graph, vertex_buffer);
+            break;
+        }
+        case 18: {
+            parents.push_back(&graph);
+            current.store(fork_graph(graph));
+            std::cout << "Working on fork " << parents.size() << "\n";
+            break;
+        }
+        case 19: {
+            if (parents.empty()) {
+                std::cout << "The graph is not a fork\n";
+                break;
+            }
+            free_graph_async(current.exchange(parents.back()));
+            parents.pop_back();
+            std::cout << "Fork discarded\n";
+            break;
+        }
+        case 20: {
+            opt20(graph);
+            break;
+        }
+        case 21: {
+            opt21(graph);
+            break;
+        }
+        case 22: {
+            opt22(graph);
+            break;
+        }
+        case 23: {
+            opt23(graph);
+            break;
+        }
+        case 24: {
+            opt24(graph);
+            break;
+        }
+        case 25: {
+            opt25(graph);
+            break;
+        }
+        case 26: {
+            opt26(graph);
+            break;
+        }
+        case 27: {
+            opt27(graph);
+            break;
+        }
+        case 28: {
+            opt28(graph);
+            break;
+        }
+        case 29: {
+            opt29(graph);
+            break;
+        }
+        case 30: {
+            opt30(graph);
+            break;
+        }
+        case 31: {
+            opt31(graph);
+            break;
+        }
+        case 32: {
+            opt32(graph);
+            break;
+        }
+        case 33: {
+            opt33(graph);
+            break;
+        }
+        case 34: {
+            opt34(graph);
+            break;
+        }
+        case 35: {
+            opt35(graph);
+            break;
+        }
+        case 36: {
+            opt36();
+            break;
+        }
+        case 37: {
+            Graph *generated = opt37(vertex_buffer);
+            if (generated) replace_graph(current, parents, generated);
+            break;
+        }
+        case 38: {
+            opt38();
             break;
         }
     }
@@ -161,33 +306,27 @@ int main_loop(char *filename, uint32_t vertex_buffer) {
     // /////////////////////////////////////////////////////////////////
     // Declaring variables /////////////////////////////////////////////
     // /////////////////////////////////////////////////////////////////
-    int exit_value = 0;
-    std::unordered_map<uint32_t, uint32_t *> inbound;
-    std::unordered_map<uint32_t, uint32_t *> outbound;
-    std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-        costs;
-    IdManager id_manager;
-
-    uint32_t vertices, edges;
+    // the graph being served, replaced atomically when a reload finishes
+    std::atomic<Graph *> current{load_graph(filename, vertex_buffer)};
+    GraphReloader reloader;
+    std::vector<Graph *> parents;  // graphs the current one was forked from
     int ccond = 0;
 
     // /////////////////////////////////////////////////////////////////
     // End of declaring variables //////////////////////////////////////
     // /////////////////////////////////////////////////////////////////
 
+    if (current.load() == nullptr) return 0;
+
     // /////////////////////////////////////////////////////////////////
     // Start main loop /////////////////////////////////////////////////
     // /////////////////////////////////////////////////////////////////
 
-    // int a;
-    // std::cin >> a;
-    read_data(inbound, outbound, costs, vertices, edges, filename,
-              vertex_buffer, id_manager);
     while (!ccond) {
+        poll_reload(reloader, current, parents);
         print_menu();
-        ccond = choose_option(inbound, outbound, costs, id_manager, vertices,
-                              edges, vertex_buffer, filename);
-        if (ccond == 2) exit_value = 2;
+        ccond = choose_option(current, reloader, parents, vertex_buffer,
+                              filename);
     }
 
     // /////////////////////////////////////////////////////////////////
@@ -195,17 +334,13 @@ int main_loop(char *filename, uint32_t vertex_buffer) {
     // /////////////////////////////////////////////////////////////////
 
     // Free dynamically allocated memory before exiting
-    for (auto &entry : outbound) {
-        free(entry.second);  // Free each allocated array
-    }
-    for (auto &entry : inbound) {
-        free(entry.second);
-    }
+    stop_reload(reloader);
+    free_graph(current.exchange(nullptr));
+    for (Graph *parent : parents) free_graph(parent);
     std::cout.flush();
-    return exit_value;
+    return 0;
 }
 int main(int argc, char **argv) {
-    auto start_time = std::chrono::high_resolution_clock::now();
     if (argc < 2) {
         std::cout << "No file specified. Exiting...\n";
         return 0;
@@ -215,20 +350,15 @@ int main(int argc, char **argv) {
     if (argc >= 3) {
         vertex_buffer = std::stoi(argv[2]);
     }
+    // NUMA placement, on by default on machines with several nodes
+    if (argc >= 4) set_numa_mode(std::stoi(argv[3]) != 0);
+    if (numa_active()) {
+        std::cout << "NUMA mode on " << numa_topology().nodes.size()
+                  << " nodes\n";
+    }
     char filename[100];
     strcpy(filename, argv[1]);
 
-    int running = 1;
-
-    while (running) {
-        running = main_loop(filename, vertex_buffer);
-    }
-
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-        end_time - start_time);
-
-    std::cout << "Process took " << duration.count()
-              << " milliseconds to perform.\n";
+    main_loop(filename, vertex_buffer);
     return 0;
 }
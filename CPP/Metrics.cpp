@@ -0,0 +1,404 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "HwCounters.h"
+#include "Metrics.h"
+
+#define SUB_BUCKETS (1u << METRIC_SUB_BITS)
+// Powers of two of nanoseconds the Prometheus buckets end at
+#define PROMETHEUS_FIRST_BITS 10
+#define PROMETHEUS_LAST_BITS 36
+
+// Counts of one thread. Only that thread writes them, so it can update
+// them with plain loads and stores; they are atomic so readers may look at
+// any time. Counts made before the current epoch are stale and read as 0.
+struct ThreadMetrics {
+    std::atomic<uint32_t> epoch{0};
+    std::atomic<uint64_t> calls[OPERATION_COUNT];
+    std::atomic<uint64_t> items[OPERATION_COUNT];
+    std::atomic<uint64_t> total_ns[OPERATION_COUNT];
+    std::atomic<uint64_t> max_ns[OPERATION_COUNT];
+    std::atomic<uint64_t> buckets[OPERATION_COUNT][METRIC_BUCKETS];
+    std::atomic<uint64_t> counted[OPERATION_COUNT][HW_COUNTER_COUNT];
+    std::atomic<uint64_t> events[OPERATION_COUNT][HW_COUNTER_COUNT];
+};
+
+struct MetricsRegistry {
+    std::mutex lock;  // guards threads and retired
+    std::vector<ThreadMetrics *> threads;
+    ThreadMetrics retired;  // counts of the threads that have exited
+};
+
+// Frees the calling thread's counts when it exits
+struct ThreadSlot {
+    ThreadMetrics *metrics = nullptr;
+    ~ThreadSlot();
+};
+
+static const char *const operation_names[OPERATION_COUNT] = {
+    "read_data",
+    "write_data",
+    "check_edges",
+    "get_degree",
+    "get_vertices_connections",
+    "get_weights_of_edges",
+    "change_weights_of_edges",
+    "add_vertices",
+    "remove_vertices",
+    "add_edges",
+    "remove_edges",
+    "get_hop_distances",
+    "get_multi_hop_distances",
+    "get_distances",
+    "get_shortest_path",
+    "apply_delta"};
+
+static std::atomic<bool> recording(true);
+static std::atomic<uint32_t> current_epoch(1);
+static thread_local ThreadSlot slot;
+
+// Never freed, as pool threads may exit after static objects are destroyed
+static MetricsRegistry &registry() {
+    static MetricsRegistry *metrics = new MetricsRegistry();
+    return *metrics;
+}
+
+static void bump(std::atomic<uint64_t> &counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+}
+
+static void clear(ThreadMetrics &metrics) {
+    for (uint32_t op = 0; op < OPERATION_COUNT; op++) {
+        metrics.calls[op].store(0, std::memory_order_relaxed);
+        metrics.items[op].store(0, std::memory_order_relaxed);
+        metrics.total_ns[op].store(0, std::memory_order_relaxed);
+        metrics.max_ns[op].store(0, std::memory_order_relaxed);
+        for (auto &bucket : metrics.buckets[op])
+            bucket.store(0, std::memory_order_relaxed);
+        for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+            metrics.counted[op][c].store(0, std::memory_order_relaxed);
+            metrics.events[op][c].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Adds the counts of `from` to `to`, taking the larger maximum
+static void merge(ThreadMetrics &to, const ThreadMetrics &from) {
+    for (uint32_t op = 0; op < OPERATION_COUNT; op++) {
+        bump(to.calls[op], from.calls[op].load(std::memory_order_relaxed));
+        bump(to.items[op], from.items[op].load(std::memory_order_relaxed));
+        bump(to.total_ns[op],
+             from.total_ns[op].load(std::memory_order_relaxed));
+        to.max_ns[op].store(
+            std::max(to.max_ns[op].load(std::memory_order_relaxed),
+                     from.max_ns[op].load(std::memory_order_relaxed)),
+            std::memory_order_relaxed);
+        for (uint32_t b = 0; b < METRIC_BUCKETS; b++) {
+            bump(to.buckets[op][b],
+                 from.buckets[op][b].load(std::memory_order_relaxed));
+        }
+        for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+            bump(to.counted[op][c],
+                 from.counted[op][c].load(std::memory_order_relaxed));
+            bump(to.events[op][c],
+                 from.events[op][c].load(std::memory_order_relaxed));
+        }
+    }
+}
+
+ThreadSlot::~ThreadSlot() {
+    if (metrics == nullptr) return;
+    MetricsRegistry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    if (metrics->epoch.load() == current_epoch.load())
+        merge(r.retired, *metrics);
+    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), metrics));
+    delete metrics;
+}
+
+static ThreadMetrics &own_metrics() {
+    if (slot.metrics == nullptr) {
+        ThreadMetrics *metrics = new ThreadMetrics();
+        MetricsRegistry &r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.threads.push_back(metrics);
+        slot.metrics = metrics;
+    }
+    ThreadMetrics &metrics = *slot.metrics;
+    uint32_t epoch = current_epoch.load(std::memory_order_acquire);
+    if (metrics.epoch.load(std::memory_order_relaxed) != epoch) {
+        clear(metrics);
+        metrics.epoch.store(epoch, std::memory_order_release);
+    }
+    return metrics;
+}
+
+static uint32_t bucket_of(uint64_t ns) {
+    if (ns < SUB_BUCKETS) return static_cast<uint32_t>(ns);
+    uint32_t bits = 63 - __builtin_clzll(ns);
+    if (bits >= METRIC_MAX_BITS) return METRIC_BUCKETS - 1;
+    return ((bits - METRIC_SUB_BITS + 1) << METRIC_SUB_BITS) +
+           ((ns >> (bits - METRIC_SUB_BITS)) & (SUB_BUCKETS - 1));
+}
+
+// Highest latency that falls in a bucket
+static uint64_t bucket_high(uint32_t bucket) {
+    if (bucket < SUB_BUCKETS) return bucket;
+    uint32_t group = bucket >> METRIC_SUB_BITS;
+    uint64_t low = static_cast<uint64_t>(SUB_BUCKETS +
+                                         (bucket & (SUB_BUCKETS - 1)))
+                   << (group - 1);
+    return low + (static_cast<uint64_t>(1) << (group - 1)) - 1;
+}
+
+// The counters are read outside the timed span, so their system calls do
+// not add to the latency
+OperationTimer::OperationTimer(uint32_t operation)
+    : operation(operation),
+      active(recording.load(std::memory_order_relaxed)),
+      counting(false) {
+    if (!active) return;
+    counting = hw_counters_enabled() && hw_counters_read(counters);
+    start = std::chrono::steady_clock::now();
+}
+
+OperationTimer::~OperationTimer() {
+    if (!active) return;
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    HwSample end;
+    if (!counting || !hw_counters_read(end)) {
+        record_operation(operation, ns, items);
+        return;
+    }
+    end.valid &= counters.valid;
+    for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+        // scaling a multiplexed counter can make it step back
+        end.values[c] = end.values[c] > counters.values[c]
+                            ? end.values[c] - counters.values[c]
+                            : 0;
+    }
+    record_operation(operation, ns, items, &end);
+}
+
+void set_metrics_enabled(bool enabled) { recording.store(enabled); }
+
+bool metrics_enabled() { return recording.load(); }
+
+void record_operation(uint32_t operation, uint64_t ns, uint64_t items,
+                      const HwSample *events) {
+    if (operation >= OPERATION_COUNT) return;
+    ThreadMetrics &metrics = own_metrics();
+    bump(metrics.calls[operation], 1);
+    bump(metrics.items[operation], items);
+    bump(metrics.total_ns[operation], ns);
+    if (ns > metrics.max_ns[operation].load(std::memory_order_relaxed))
+        metrics.max_ns[operation].store(ns, std::memory_order_relaxed);
+    bump(metrics.buckets[operation][bucket_of(ns)], 1);
+    if (events == nullptr) return;
+    for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+        if (!(events->valid & (1u << c))) continue;
+        bump(metrics.counted[operation][c], 1);
+        bump(metrics.events[operation][c], events->values[c]);
+    }
+}
+
+const char *operation_name(uint32_t operation) {
+    return operation < OPERATION_COUNT ? operation_names[operation]
+                                       : "unknown";
+}
+
+std::vector<OperationMetrics> metrics_snapshot() {
+    std::vector<OperationMetrics> snapshot(OPERATION_COUNT);
+    ThreadMetrics *total = new ThreadMetrics();
+    MetricsRegistry &r = registry();
+    {
+        std::lock_guard<std::mutex> guard(r.lock);
+        uint32_t epoch = current_epoch.load();
+        merge(*total, r.retired);
+        for (ThreadMetrics *metrics : r.threads) {
+            if (metrics->epoch.load(std::memory_order_acquire) == epoch)
+                merge(*total, *metrics);
+        }
+    }
+    for (uint32_t op = 0; op < OPERATION_COUNT; op++) {
+        OperationMetrics &entry = snapshot[op];
+        entry.name = operation_names[op];
+        entry.calls = total->calls[op].load();
+        entry.items = total->items[op].load();
+        entry.total_ns = total->total_ns[op].load();
+        entry.max_ns = total->max_ns[op].load();
+        entry.buckets.resize(METRIC_BUCKETS);
+        for (uint32_t b = 0; b < METRIC_BUCKETS; b++)
+            entry.buckets[b] = total->buckets[op][b].load();
+        for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+            entry.counted[c] = total->counted[op][c].load();
+            entry.events[c] = total->events[op][c].load();
+        }
+    }
+    delete total;
+    return snapshot;
+}
+
+void reset_metrics() {
+    MetricsRegistry &r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    current_epoch++;
+    clear(r.retired);
+}
+
+uint64_t latency_quantile(const OperationMetrics &metrics, double fraction) {
+    if (metrics.calls == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * metrics.calls));
+    rank = std::min(std::max<uint64_t>(rank, 1), metrics.calls);
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < metrics.buckets.size(); b++) {
+        seen += metrics.buckets[b];
+        if (seen < rank) continue;
+        // the last bucket has no upper bound
+        if (b + 1 == METRIC_BUCKETS) return metrics.max_ns;
+        return std::min(bucket_high(b), metrics.max_ns);
+    }
+    return metrics.max_ns;
+}
+
+void write_metrics_prometheus(std::ostream &out) {
+    std::vector<OperationMetrics> snapshot = metrics_snapshot();
+    std::streamsize precision = out.precision(9);
+
+    out << "# HELP graph_operation_items_total Vertices, edges or queries "
+           "handled by each graph operation.\n"
+        << "# TYPE graph_operation_items_total counter\n";
+    for (const OperationMetrics &m : snapshot) {
+        out << "graph_operation_items_total{operation=\"" << m.name << "\"} "
+            << m.items << "\n";
+    }
+
+    out << "# HELP graph_operation_max_seconds Slowest call of each graph "
+           "operation since the last reset.\n"
+        << "# TYPE graph_operation_max_seconds gauge\n";
+    for (const OperationMetrics &m : snapshot) {
+        out << "graph_operation_max_seconds{operation=\"" << m.name << "\"} "
+            << m.max_ns / 1e9 << "\n";
+    }
+
+    out << "# HELP graph_operation_duration_seconds Latency of each graph "
+           "operation.\n"
+        << "# TYPE graph_operation_duration_seconds histogram\n";
+    for (const OperationMetrics &m : snapshot) {
+        // powers of two are bucket boundaries, so these counts are exact
+        uint64_t below = 0;
+        uint32_t b = 0;
+        for (uint32_t bits = PROMETHEUS_FIRST_BITS;
+             bits <= PROMETHEUS_LAST_BITS; bits++) {
+            uint32_t end = bucket_of(static_cast<uint64_t>(1) << bits);
+            for (; b < end; b++) below += m.buckets[b];
+            out << "graph_operation_duration_seconds_bucket{operation=\""
+                << m.name << "\",le=\""
+                << (static_cast<uint64_t>(1) << bits) / 1e9 << "\"} " << below
+                << "\n";
+        }
+        out << "graph_operation_duration_seconds_bucket{operation=\""
+            << m.name << "\",le=\"+Inf\"} " << m.calls << "\n";
+        out << "graph_operation_duration_seconds_sum{operation=\"" << m.name
+            << "\"} " << m.total_ns / 1e9 << "\n";
+        out << "graph_operation_duration_seconds_count{operation=\""
+            << m.name << "\"} " << m.calls << "\n";
+    }
+
+    out << "# HELP graph_operation_hardware_events_total Hardware events "
+           "counted in each graph operation.\n"
+        << "# TYPE graph_operation_hardware_events_total counter\n";
+    for (const OperationMetrics &m : snapshot) {
+        for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+            if (m.counted[c] == 0) continue;
+            out << "graph_operation_hardware_events_total{operation=\""
+                << m.name << "\",event=\"" << hw_counter_name(c) << "\"} "
+                << m.events[c] << "\n";
+        }
+    }
+    out << "# HELP graph_operation_hardware_calls_total Calls of each graph "
+           "operation the hardware events were counted over.\n"
+        << "# TYPE graph_operation_hardware_calls_total counter\n";
+    for (const OperationMetrics &m : snapshot) {
+        for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+            if (m.counted[c] == 0) continue;
+            out << "graph_operation_hardware_calls_total{operation=\""
+                << m.name << "\",event=\"" << hw_counter_name(c) << "\"} "
+                << m.counted[c] << "\n";
+        }
+    }
+    out.precision(precision);
+}
+
+void write_metrics_json(std::ostream &out) {
+    std::vector<OperationMetrics> snapshot = metrics_snapshot();
+    out << "{\n  \"operations\": [\n";
+    for (uint32_t op = 0; op < snapshot.size(); op++) {
+        const OperationMetrics &m = snapshot[op];
+        out << "    {\"operation\": \"" << m.name << "\", \"calls\": "
+            << m.calls << ", \"items\": " << m.items
+            << ", \"latency_us\": {\"mean\": "
+            << (m.calls ? m.total_ns / 1e3 / m.calls : 0)
+            << ", \"p50\": " << latency_quantile(m, 0.5) / 1e3
+            << ", \"p90\": " << latency_quantile(m, 0.9) / 1e3
+            << ", \"p99\": " << latency_quantile(m, 0.99) / 1e3
+            << ", \"p999\": " << latency_quantile(m, 0.999) / 1e3
+            << ", \"max\": " << m.max_ns / 1e3 << "},\n"
+            << "     \"buckets_ns\": [";
+        // every non-empty bucket as [highest latency, calls]
+        bool first = true;
+        for (uint32_t b = 0; b < m.buckets.size(); b++) {
+            if (m.buckets[b] == 0) continue;
+            out << (first ? "" : ", ") << "[" << bucket_high(b) << ", "
+                << m.buckets[b] << "]";
+            first = false;
+        }
+        out << "],\n     \"hardware\": {";
+        // per counter: the calls it was read in and its events per call
+        first = true;
+        for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+            if (m.counted[c] == 0) continue;
+            out << (first ? "" : ", ") << "\"" << hw_counter_name(c)
+                << "\": {\"calls\": " << m.counted[c]
+                << ", \"per_call\": "
+                << static_cast<double>(m.events[c]) / m.counted[c] << "}";
+            first = false;
+        }
+        out << "}}" << (op + 1 < snapshot.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef METRICS_H_
+#define METRICS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "HwCounters.h"
+
+// Every thread records its own calls, so recording takes no lock and
+// touches no shared cache line; readers merge the threads' counts. Latencies
+// go to log-linear buckets: every power of two of nanoseconds is split into
+// 2^METRIC_SUB_BITS buckets, so a quantile is off by at most 1/16 of its
+// value. When hardware counters are on, every call also records how many
+// cycles, instructions, LLC misses and branch misses the calling thread
+// spent in it; work that a call hands to other threads is not counted.
+
+#define OPERATION_READ_DATA 0
+#define OPERATION_WRITE_DATA 1
+#define OPERATION_CHECK_EDGES 2
+#define OPERATION_GET_DEGREE 3
+#define OPERATION_GET_CONNECTIONS 4
+#define OPERATION_GET_WEIGHTS 5
+#define OPERATION_CHANGE_WEIGHTS 6
+#define OPERATION_ADD_VERTICES 7
+#define OPERATION_REMOVE_VERTICES 8
+#define OPERATION_ADD_EDGES 9
+#define OPERATION_REMOVE_EDGES 10
+#define OPERATION_HOP_DISTANCES 11
+#define OPERATION_MULTI_HOP_DISTANCES 12
+#define OPERATION_DISTANCES 13
+#define OPERATION_SHORTEST_PATH 14
+#define OPERATION_APPLY_DELTA 15
+#define OPERATION_COUNT 16
+
+#define METRIC_SUB_BITS 4
+// Latencies from 2^METRIC_MAX_BITS ns (about 18 minutes) on share the last
+// bucket
+#define METRIC_MAX_BITS 40
+#define METRIC_BUCKETS \
+    ((METRIC_MAX_BITS - METRIC_SUB_BITS + 1) << METRIC_SUB_BITS)
+
+/**
+ * @brief Merged counts of one operation since the last reset.
+ */
+struct OperationMetrics {
+    const char *name = nullptr;     ///< Name of the operation.
+    uint64_t calls = 0;             ///< Calls recorded.
+    uint64_t items = 0;             ///< Vertices, edges or queries handled.
+    uint64_t total_ns = 0;          ///< Time spent in all calls.
+    uint64_t max_ns = 0;            ///< Slowest call.
+    std::vector<uint64_t> buckets;  ///< Calls per latency bucket.
+    /// Calls that read each hardware counter.
+    uint64_t counted[HW_COUNTER_COUNT] = {0};
+    /// Events of each hardware counter over those calls.
+    uint64_t events[HW_COUNTER_COUNT] = {0};
+};
+
+/**
+ * @brief Times one call of an operation, from construction to destruction.
+ *
+ * Functions with several exits only need to set `items` before leaving.
+ */
+struct OperationTimer {
+    uint32_t operation;  ///< One of the OPERATION_ constants.
+    uint64_t items = 0;  ///< Items handled by the call.
+    bool active;         ///< Whether metrics were on at the start.
+    bool counting;       ///< Whether hardware counters were read.
+    HwSample counters;   ///< Hardware counters at the start.
+    std::chrono::steady_clock::time_point start;
+
+    explicit OperationTimer(uint32_t operation);
+    ~OperationTimer();
+};
+
+/**
+ * @brief Turns recording on or off; it is on by default.
+ * @param enabled Whether calls are recorded.
+ */
+void set_metrics_enabled(bool enabled);
+
+/**
+ * @brief Tells whether calls are being recorded.
+ * @return bool True if recording is on.
+ */
+bool metrics_enabled();
+
+/**
+ * @brief Records one call of an operation made by the calling thread.
+ * @param operation One of the OPERATION_ constants.
+ * @param ns        Time the call took, in nanoseconds.
+ * @param items     Items the call handled.
+ * @param events    Hardware events of the call, if they were counted.
+ */
+void record_operation(uint32_t operation, uint64_t ns, uint64_t items,
+                      const HwSample *events = nullptr);
+
+/**
+ * @brief Returns the name of an operation.
+ * @param operation One of the OPERATION_ constants.
+ * @return const char* The name of the timed function.
+ */
+const char *operation_name(uint32_t operation);
+
+/**
+ * @brief Merges the counts of all threads.
+ * @return std::vector<OperationMetrics> One entry per operation, indexed by
+ * the OPERATION_ constants.
+ */
+std::vector<OperationMetrics> metrics_snapshot();
+
+/**
+ * @brief Forgets every recorded call.
+ *
+ * Threads drop their own counts the next time they record, so a reset
+ * never races with them.
+ */
+void reset_metrics();
+
+/**
+ * @brief Estimates a latency quantile of an operation.
+ * @param metrics  The merged counts of the operation.
+ * @param fraction The quantile, between 0 and 1.
+ * @return uint64_t The highest latency of the bucket holding the quantile,
+ * in nanoseconds, or 0 without calls.
+ */
+uint64_t latency_quantile(const OperationMetrics &metrics, double fraction);
+
+/**
+ * @brief Writes the metrics in the Prometheus text exposition format.
+ *
+ * Latencies become a histogram in seconds, with one bucket per power of two
+ * of nanoseconds from about 1 microsecond to about 1 minute. Hardware events
+ * are counters labeled by operation and event, next to the number of calls
+ * they were counted over.
+ * @param out The stream to write to.
+ */
+void write_metrics_prometheus(std::ostream &out);
+
+/**
+ * @brief Writes the metrics as JSON, with the usual quantiles, the
+ * non-empty latency buckets and the counted hardware events of every
+ * operation.
+ * @param out The stream to write to.
+ */
+void write_metrics_json(std::ostream &out);
+
+#endif  // METRICS_H_
@@ -0,0 +1,192 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Numa.h"
+
+// Values of the Linux memory policy interface, kept here so that the
+// program does not depend on libnuma
+#define NUMA_MPOL_PREFERRED 1
+#define NUMA_MPOL_MF_MOVE (1 << 1)
+
+static std::atomic<bool> numa_wanted(true);
+
+// Parses a sysfs list such as "0-3,8,10-11"
+static std::vector<uint32_t> parse_list(const std::string &text) {
+    std::vector<uint32_t> values;
+    std::stringstream input(text);
+    std::string part;
+    while (std::getline(input, part, ',')) {
+        size_t dash = part.find('-');
+        try {
+            uint32_t first = std::stoul(part.substr(0, dash));
+            uint32_t last = dash == std::string::npos
+                                ? first
+                                : std::stoul(part.substr(dash + 1));
+            for (uint32_t v = first; v <= last; v++) values.push_back(v);
+        } catch (std::exception &e) {
+            continue;
+        }
+    }
+    return values;
+}
+
+static std::string read_line(const std::string &filename) {
+    std::ifstream input(filename);
+    std::string line;
+    std::getline(input, line);
+    return line;
+}
+
+// CPUs this process may run on
+static std::vector<uint8_t> allowed_cpus(uint32_t count) {
+    std::vector<uint8_t> allowed(count, 1);
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (uint32_t cpu = 0; cpu < count; cpu++)
+            allowed[cpu] = cpu < CPU_SETSIZE && CPU_ISSET(cpu, &set);
+    }
+#endif
+    return allowed;
+}
+
+NumaTopology read_numa_topology(const std::string &root) {
+    NumaTopology topology;
+    std::vector<uint32_t> online = parse_list(read_line(root + "/online"));
+    std::vector<std::vector<uint32_t>> cpus;
+    uint32_t highest = 0;
+    for (uint32_t node : online) {
+        cpus.push_back(parse_list(
+            read_line(root + "/node" + std::to_string(node) + "/cpulist")));
+        for (uint32_t cpu : cpus.back()) highest = std::max(highest, cpu + 1);
+    }
+
+    std::vector<uint8_t> allowed = allowed_cpus(highest);
+    for (size_t i = 0; i < online.size(); i++) {
+        std::vector<uint32_t> usable;
+        for (uint32_t cpu : cpus[i]) {
+            if (allowed[cpu]) usable.push_back(cpu);
+        }
+        if (usable.empty()) continue;
+        topology.nodes.push_back(online[i]);
+        topology.cpus.push_back(usable);
+    }
+
+    if (topology.nodes.empty()) {
+        uint32_t count = std::max(1u, std::thread::hardware_concurrency());
+        topology.nodes.assign(1, 0);
+        topology.cpus.assign(1, std::vector<uint32_t>());
+        for (uint32_t cpu = 0; cpu < count; cpu++)
+            topology.cpus[0].push_back(cpu);
+    }
+    return topology;
+}
+
+const NumaTopology &numa_topology() {
+    static const NumaTopology topology = read_numa_topology();
+    return topology;
+}
+
+bool set_numa_mode(bool enabled) {
+    numa_wanted.store(enabled);
+    return numa_active();
+}
+
+bool numa_active() {
+    return numa_wanted.load(std::memory_order_relaxed) &&
+           numa_topology().nodes.size() > 1;
+}
+
+void numa_slice(size_t begin, size_t end, uint32_t node, uint32_t workers,
+                size_t &from, size_t &to) {
+    uint32_t nodes = static_cast<uint32_t>(numa_topology().nodes.size());
+    if (workers == 0) workers = 1;
+    // workers w with w % nodes == k belong to node k
+    auto workers_before = [&](uint32_t k) -> uint64_t {
+        return static_cast<uint64_t>(workers / nodes) * k +
+               std::min(k, workers % nodes);
+    };
+    uint64_t size = end - begin;
+    from = begin + size * workers_before(node) / workers;
+    to = begin + size * workers_before(node + 1) / workers;
+}
+
+bool numa_pin_thread(uint32_t node) {
+#if defined(__linux__)
+    const NumaTopology &topology = numa_topology();
+    if (node >= topology.cpus.size()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : topology.cpus[node]) {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+bool numa_place(const void *begin, const void *end, uint32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    const NumaTopology &topology = numa_topology();
+    if (node >= topology.nodes.size()) return false;
+    uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t first = (reinterpret_cast<uintptr_t>(begin) + page - 1) /
+                      page * page;
+    uintptr_t last = (reinterpret_cast<uintptr_t>(end) + page - 1) /
+                     page * page;
+    if (first >= last) return true;
+
+    uint32_t id = topology.nodes[node];
+    const size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(id / bits + 1, 0);
+    mask[id / bits] |= 1ul << (id % bits);
+    // the kernel reads maxnode - 1 bits of the mask
+    return syscall(SYS_mbind, first, last - first, NUMA_MPOL_PREFERRED,
+                   mask.data(), mask.size() * bits + 1,
+                   NUMA_MPOL_MF_MOVE) == 0;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef NUMA_H_
+#define NUMA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The memory nodes of the machine and the CPUs attached to them.
+ *
+ * Only nodes with CPUs this process may run on are listed; memory-only
+ * nodes cannot host workers.
+ */
+struct NumaTopology {
+    std::vector<uint32_t> nodes;              ///< Node number of each entry.
+    std::vector<std::vector<uint32_t>> cpus;  ///< CPUs of each node.
+};
+
+/**
+ * @brief Reads the NUMA topology from sysfs.
+ *
+ * Falls back to a single node holding every CPU when the directory cannot
+ * be read, as on machines or kernels without NUMA support.
+ * @param root The sysfs node directory.
+ * @return NumaTopology The nodes found.
+ */
+NumaTopology read_numa_topology(
+    const std::string &root = "/sys/devices/system/node");
+
+/**
+ * @brief Returns the topology of this machine, read on first use.
+ * @return const NumaTopology& The topology.
+ */
+const NumaTopology &numa_topology();
+
+/**
+ * @brief Turns the NUMA mode on or off.
+ *
+ * In NUMA mode parallel loops give every node a contiguous slice of their
+ * range, pin the workers of that slice to the node's CPUs, and CSR copies
+ * move the pages of each slice to its node. The mode only takes effect on
+ * machines with more than one node.
+ * @param enabled Whether the mode is wanted.
+ * @return bool Whether the mode is now active.
+ */
+bool set_numa_mode(bool enabled);
+
+/**
+ * @brief Tells whether the NUMA mode is active.
+ * @return bool The mode is on and the machine has several nodes.
+ */
+bool numa_active();
+
+/**
+ * @brief Returns the slice of a range that belongs to a node.
+ *
+ * Workers are dealt to the nodes in turn, and every node gets a share of
+ * the range proportional to its workers, so parallel loops and data
+ * placement agree on which node owns an index.
+ * @param begin   First index of the range.
+ * @param end     One past the last index of the range.
+ * @param node    Index of the node in numa_topology().
+ * @param workers Number of workers the range is split over.
+ * @param from    Set to the first index of the slice.
+ * @param to      Set to one past the last index of the slice.
+ */
+void numa_slice(size_t begin, size_t end, uint32_t node, uint32_t workers,
+                size_t &from, size_t &to);
+
+/**
+ * @brief Restricts the calling thread to the CPUs of a node.
+ * @param node Index of the node in numa_topology().
+ * @return bool Whether the thread was pinned.
+ */
+bool numa_pin_thread(uint32_t node);
+
+/**
+ * @brief Moves the memory pages of a range of bytes to a node.
+ *
+ * Both ends are rounded up to page boundaries, so adjacent ranges placed on
+ * different nodes split their pages without overlap.
+ * @param begin Start of the range.
+ * @param end   End of the range.
+ * @param node  Index of the node in numa_topology().
+ * @return bool Whether the kernel accepted the placement.
+ */
+bool numa_place(const void *begin, const void *end, uint32_t node);
+
+#endif  // NUMA_H_
@@ -0,0 +1,165 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Csr.h"
+#include "Data.h"
+#include "PageRank.h"
+#include "Parallel.h"
+#include "Structures.h"
+
+#define PAGERANK_GRAIN 4096
+
+// Sum of rank[sources[e]] * factor[e] over [from, to). Four independent
+// accumulators break the dependency on a single sum so the compiler can keep
+// several multiply-adds in flight and vectorize the loop.
+static inline double pull(const uint32_t *sources, const float *factor,
+                          const double *rank, uint64_t from, uint64_t to) {
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    uint64_t e = from;
+    for (; e + 4 <= to; e += 4) {
+        s0 += rank[sources[e]] * factor[e];
+        s1 += rank[sources[e + 1]] * factor[e + 1];
+        s2 += rank[sources[e + 2]] * factor[e + 2];
+        s3 += rank[sources[e + 3]] * factor[e + 3];
+    }
+    for (; e < to; e++) s0 += rank[sources[e]] * factor[e];
+    return (s0 + s1) + (s2 + s3);
+}
+
+std::vector<double> pagerank(const CsrGraph &csr, bool weighted,
+                             double damping, double tolerance,
+                             uint32_t max_iterations, PageRankStats *stats) {
+    uint32_t n = csr.n;
+    size_t chunks = (static_cast<size_t>(n) + PAGERANK_GRAIN - 1) /
+                    PAGERANK_GRAIN;
+    uint32_t present = 0;
+    for (uint32_t v = 0; v < n; v++) present += csr.present[v];
+    std::vector<double> rank(n, 0.0), next(n, 0.0);
+    if (present == 0) return rank;
+
+    // total weight each vertex hands out, 0 for dangling vertices
+    std::vector<double> out_total(n, 0.0);
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++) {
+            double total = 0;
+            for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+                 e++)
+                total += weighted ? csr.out_weights[e] : 1.0;
+            out_total[v] = total;
+        }
+    });
+    std::vector<float> factor(csr.in_sources.size());
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++) {
+            for (uint64_t e = csr.in_offsets[v]; e < csr.in_offsets[v + 1];
+                 e++) {
+                double share = weighted ? csr.in_weights[e] : 1.0;
+                double total = out_total[csr.in_sources[e]];
+                factor[e] = total > 0 ? static_cast<float>(share / total) : 0;
+            }
+        }
+    });
+
+    for (uint32_t v = 0; v < n; v++) {
+        if (csr.present[v]) rank[v] = 1.0 / present;
+    }
+    std::vector<double> partial(chunks);
+    for (uint32_t it = 0; it < max_iterations; it++) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // a single thread runs the whole range as one chunk
+        std::fill(partial.begin(), partial.end(), 0.0);
+        parallel_for(
+            0, n,
+            [&](size_t from, size_t to) {
+                double local = 0;
+                for (size_t v = from; v < to; v++) {
+                    if (csr.present[v] && out_total[v] == 0) local += rank[v];
+                }
+                partial[from / PAGERANK_GRAIN] = local;
+            },
+            PAGERANK_GRAIN);
+        double dangling = 0;
+        for (double p : partial) dangling += p;
+        double base = (1.0 - damping + damping * dangling) / present;
+
+        std::fill(partial.begin(), partial.end(), 0.0);
+        parallel_for(
+            0, n,
+            [&](size_t from, size_t to) {
+                double local = 0;
+                for (size_t v = from; v < to; v++) {
+                    if (!csr.present[v]) continue;
+                    next[v] = base + damping * pull(csr.in_sources.data(),
+                                                    factor.data(), rank.data(),
+                                                    csr.in_offsets[v],
+                                                    csr.in_offsets[v + 1]);
+                    local += std::fabs(next[v] - rank[v]);
+                }
+                partial[from / PAGERANK_GRAIN] = local;
+            },
+            PAGERANK_GRAIN);
+        double residual = 0;
+        for (double p : partial) residual += p;
+        rank.swap(next);
+
+        if (stats) {
+            auto end = std::chrono::high_resolution_clock::now();
+            stats->iteration_ms.push_back(
+                std::chrono::duration<double, std::milli>(end - start)
+                    .count());
+            stats->residuals.push_back(residual);
+        }
+        if (residual < tolerance) {
+            if (stats) stats->converged = true;
+            break;
+        }
+    }
+    return rank;
+}
+
+double *get_pagerank(Graph &graph, uint32_t *list_of_vertices, bool weighted,
+                     PageRankStats &stats) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<double> rank =
+        pagerank(*csr, weighted, 0.85, 1e-9, 100, &stats);
+
+    double *result = new double[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < rank.size() ? rank[v] : 0;
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
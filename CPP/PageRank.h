@@ -0,0 +1,84 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef PAGERANK_H_
+#define PAGERANK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Progress of a PageRank computation.
+ */
+struct PageRankStats {
+    std::vector<double> iteration_ms;  ///< Duration of every iteration.
+    std::vector<double> residuals;     ///< L1 change of the ranks in each.
+    bool converged = false;            ///< The tolerance was reached.
+};
+
+/**
+ * @brief Computes PageRank by pulling rank along the inbound lists.
+ *
+ * Every vertex sums the contributions of its parents, so each rank is
+ * written by one thread only and no atomics are needed. The contribution
+ * factor of every inbound edge (1 / out-degree of the parent, or its weight
+ * divided by the parent's total outbound weight) is computed once, which
+ * turns each iteration into a multiply-add over contiguous arrays. Rank of
+ * vertices without outbound edges is spread evenly over all vertices.
+ *
+ * @param csr            The graph.
+ * @param weighted       Split a vertex's rank proportionally to the weights
+ * of its outbound edges instead of evenly.
+ * @param damping        Probability of following an edge.
+ * @param tolerance      Stop once the ranks change by less than this in L1
+ * norm.
+ * @param max_iterations Stop after this many iterations in any case.
+ * @param stats          If not null, filled with the progress per iteration.
+ * @return std::vector<double> Rank of every vertex, summing to 1 over the
+ * vertices in use.
+ */
+std::vector<double> pagerank(const CsrGraph &csr, bool weighted,
+                             double damping = 0.85, double tolerance = 1e-9,
+                             uint32_t max_iterations = 100,
+                             PageRankStats *stats = nullptr);
+
+/**
+ * @brief Retrieves the PageRank of a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param list_of_vertices Pointer to the list of vertices.
+ * @param weighted         Use the edge weights.
+ * @param stats            Filled with the progress per iteration.
+ * @return double* Dynamically allocated array with the number of vertices
+ * in the first cell and their ranks after it (0 for vertices not in the
+ * graph).
+ */
+double *get_pagerank(Graph &graph, uint32_t *list_of_vertices, bool weighted,
+                     PageRankStats &stats);
+
+#endif  // PAGERANK_H_
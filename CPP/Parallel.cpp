@@ -0,0 +1,519 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Numa.h"
+#include "Parallel.h"
+
+#define DEQUE_CAPACITY 256
+// A parallel loop is first halved into about 2^PARALLEL_SPLIT_DEPTH pieces
+// per worker
+#define PARALLEL_SPLIT_DEPTH 3
+// Extra halvings allowed to a piece that was stolen
+#define STEAL_SPLITS 2
+// Idle workers look at the queues again after this long even if not woken
+#define IDLE_WAIT_MS 10
+
+struct Task {
+    std::function<void()> run;
+    TaskGroup *group;  // null for detached tasks
+};
+
+// Slots of a deque; a full ring is replaced by one twice as large
+struct TaskRing {
+    int64_t capacity;
+    std::unique_ptr<std::atomic<Task *>[]> slots;
+};
+
+// Chase-Lev deque: its worker pushes and pops at the bottom, other workers
+// steal at the top. Replaced rings are kept until the deque goes away, as a
+// thief may still be reading one.
+struct WorkDeque {
+    std::atomic<int64_t> top{0};
+    std::atomic<int64_t> bottom{0};
+    std::atomic<TaskRing *> ring{nullptr};
+    std::vector<std::unique_ptr<TaskRing>> rings;
+};
+
+struct Worker {
+    WorkDeque deque;
+    std::thread thread;
+    uint32_t node = 0;
+    std::atomic<uint64_t> tasks{0};
+    std::atomic<uint64_t> steals{0};
+    std::atomic<uint64_t> busy_ns{0};
+};
+
+struct Pool {
+    std::vector<std::unique_ptr<Worker>> workers;
+    bool numa = false;
+    std::mutex lock;  // guards injected, epoch and stopping
+    std::condition_variable wake;
+    // tasks from threads outside the pool, one queue per node
+    std::vector<std::deque<Task *>> injected;
+    std::atomic<uint64_t> injected_count{0};
+    std::atomic<uint32_t> sleeping{0};
+    uint64_t epoch = 0;  // changes whenever new work may be waiting
+    std::atomic<uint64_t> in_flight{0};
+    std::atomic<bool> stopping{false};
+    std::chrono::steady_clock::time_point since;
+};
+
+// Long blocking jobs, run in order by a thread of their own
+struct BackgroundQueue {
+    std::mutex lock;
+    std::condition_variable wake;
+    std::deque<Task *> tasks;
+};
+
+static std::atomic<uint32_t> configured_workers(0);
+static std::mutex pool_lock;  // guards starting and restarting the pool
+static Pool *pool = nullptr;
+static thread_local Pool *self_pool = nullptr;
+static thread_local Worker *self = nullptr;
+static thread_local uint32_t self_index = 0;
+static thread_local uint32_t running_depth = 0;
+
+static TaskRing *add_ring(WorkDeque &deque, int64_t capacity) {
+    std::unique_ptr<TaskRing> ring(new TaskRing);
+    ring->capacity = capacity;
+    ring->slots.reset(new std::atomic<Task *>[capacity]);
+    deque.rings.push_back(std::move(ring));
+    return deque.rings.back().get();
+}
+
+static std::atomic<Task *> &slot(TaskRing *ring, int64_t index) {
+    return ring->slots[index & (ring->capacity - 1)];
+}
+
+static void deque_push(WorkDeque &deque, Task *task) {
+    int64_t bottom = deque.bottom.load(std::memory_order_relaxed);
+    int64_t top = deque.top.load(std::memory_order_acquire);
+    TaskRing *ring = deque.ring.load(std::memory_order_relaxed);
+    if (bottom - top >= ring->capacity) {
+        TaskRing *larger = add_ring(deque, ring->capacity * 2);
+        for (int64_t i = top; i < bottom; i++) {
+            slot(larger, i).store(slot(ring, i).load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+        }
+        deque.ring.store(larger, std::memory_order_release);
+        ring = larger;
+    }
+    slot(ring, bottom).store(task, std::memory_order_relaxed);
+    deque.bottom.store(bottom + 1, std::memory_order_release);
+}
+
+static Task *deque_pop(WorkDeque &deque) {
+    int64_t bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+    TaskRing *ring = deque.ring.load(std::memory_order_relaxed);
+    deque.bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = deque.top.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    Task *task = slot(ring, bottom).load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // the last task, which a thief may be taking as well
+        if (!deque.top.compare_exchange_strong(top, top + 1,
+                                               std::memory_order_seq_cst,
+                                               std::memory_order_relaxed))
+            task = nullptr;
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+static Task *deque_steal(WorkDeque &deque) {
+    int64_t top = deque.top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = deque.bottom.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+    TaskRing *ring = deque.ring.load(std::memory_order_acquire);
+    Task *task = slot(ring, top).load(std::memory_order_relaxed);
+    if (!deque.top.compare_exchange_strong(top, top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed))
+        return nullptr;
+    return task;
+}
+
+// Wakes a sleeping worker, if any, after new work was queued
+static void notify(Pool &p) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (p.sleeping.load() == 0) return;
+    {
+        std::lock_guard<std::mutex> guard(p.lock);
+        p.epoch++;
+    }
+    p.wake.notify_one();
+}
+
+static void submit(Pool &p, Task *task, uint32_t node) {
+    p.in_flight++;
+    if (self_pool == &p) {
+        deque_push(self->deque, task);
+    } else {
+        std::lock_guard<std::mutex> guard(p.lock);
+        p.injected[node % p.injected.size()].push_back(task);
+        p.injected_count++;
+    }
+    notify(p);
+}
+
+// Own deque first, then the queues of tasks from outside the pool, then the
+// other workers, those of the same node first
+static Task *find_task(Pool &p, uint32_t index) {
+    Worker &worker = *p.workers[index];
+    Task *task = deque_pop(worker.deque);
+    if (task) return task;
+
+    if (p.injected_count.load() > 0) {
+        std::lock_guard<std::mutex> guard(p.lock);
+        for (size_t i = 0; i < p.injected.size(); i++) {
+            std::deque<Task *> &queue =
+                p.injected[(worker.node + i) % p.injected.size()];
+            if (queue.empty()) continue;
+            task = queue.front();
+            queue.pop_front();
+            p.injected_count--;
+            return task;
+        }
+    }
+
+    size_t count = p.workers.size();
+    for (int same_node = 1; same_node >= 0; same_node--) {
+        for (size_t i = 1; i < count; i++) {
+            Worker &victim = *p.workers[(index + i) % count];
+            if ((victim.node == worker.node) != (same_node == 1)) continue;
+            task = deque_steal(victim.deque);
+            if (task) {
+                worker.steals.fetch_add(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+static void finish(TaskGroup *group) {
+    if (group == nullptr) return;
+    // the waiter may free the group as soon as it sees no pending task, so
+    // the count drops under the lock it takes before returning
+    std::lock_guard<std::mutex> guard(group->lock);
+    if (group->pending.fetch_sub(1) == 1) group->done.notify_all();
+}
+
+static void execute(Pool &p, Task *task) {
+    Worker &worker = *self;
+    // time spent in tasks run while waiting inside another task is counted
+    // once, as part of the outer task
+    auto start = std::chrono::steady_clock::now();
+    running_depth++;
+    task->run();
+    running_depth--;
+    if (running_depth == 0) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        worker.busy_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count(),
+            std::memory_order_relaxed);
+    }
+    worker.tasks.fetch_add(1, std::memory_order_relaxed);
+    TaskGroup *group = task->group;
+    delete task;
+    finish(group);
+    p.in_flight--;
+}
+
+static void work(Pool *p, uint32_t index) {
+    self_pool = p;
+    self = p->workers[index].get();
+    self_index = index;
+    if (p->numa) numa_pin_thread(self->node);
+
+    while (!p->stopping.load()) {
+        Task *task = find_task(*p, index);
+        if (task) {
+            execute(*p, task);
+            continue;
+        }
+        uint64_t seen;
+        {
+            std::lock_guard<std::mutex> guard(p->lock);
+            seen = p->epoch;
+        }
+        // look once more after announcing the sleep, so that a task
+        // submitted meanwhile either is found or wakes this worker
+        p->sleeping++;
+        task = find_task(*p, index);
+        if (task) {
+            p->sleeping--;
+            execute(*p, task);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(p->lock);
+        p->wake.wait_for(guard, std::chrono::milliseconds(IDLE_WAIT_MS), [&] {
+            return p->epoch != seen || p->stopping.load();
+        });
+        p->sleeping--;
+    }
+}
+
+static Pool *start_pool(uint32_t size, bool numa) {
+    Pool *p = new Pool;
+    p->numa = numa;
+    uint32_t nodes =
+        numa ? static_cast<uint32_t>(numa_topology().nodes.size()) : 1;
+    p->injected.resize(nodes);
+    p->since = std::chrono::steady_clock::now();
+    for (uint32_t w = 0; w < size; w++) {
+        p->workers.emplace_back(new Worker);
+        Worker &worker = *p->workers.back();
+        worker.node = w % nodes;
+        worker.deque.ring.store(add_ring(worker.deque, DEQUE_CAPACITY));
+    }
+    for (uint32_t w = 0; w < size; w++)
+        p->workers[w]->thread = std::thread(work, p, w);
+    return p;
+}
+
+static void stop_pool(Pool *p) {
+    {
+        std::lock_guard<std::mutex> guard(p->lock);
+        p->stopping.store(true);
+        p->epoch++;
+    }
+    p->wake.notify_all();
+    for (auto &worker : p->workers) worker->thread.join();
+    delete p;
+}
+
+// The pool of the calling worker, or the shared pool, started or resized
+// to the current settings when idle
+static Pool &get_pool() {
+    if (self_pool) return *self_pool;
+    std::lock_guard<std::mutex> guard(pool_lock);
+    uint32_t size = worker_count();
+    bool numa = numa_active();
+    if (pool && (pool->workers.size() != size || pool->numa != numa) &&
+        pool->in_flight.load() == 0) {
+        stop_pool(pool);
+        pool = nullptr;
+    }
+    if (pool == nullptr) pool = start_pool(size, numa);
+    return *pool;
+}
+
+uint32_t worker_count() {
+    uint32_t count = configured_workers.load(std::memory_order_relaxed);
+    if (count) return count;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void set_worker_count(uint32_t count) { configured_workers.store(count); }
+
+void spawn(TaskGroup &group, std::function<void()> task) {
+    group.pending++;
+    submit(get_pool(), new Task{std::move(task), &group}, 0);
+}
+
+void spawn_detached(std::function<void()> task) {
+    submit(get_pool(), new Task{std::move(task), nullptr}, 0);
+}
+
+static void run_background(BackgroundQueue *queue) {
+    while (true) {
+        Task *task;
+        {
+            std::unique_lock<std::mutex> guard(queue->lock);
+            queue->wake.wait(guard, [&] { return !queue->tasks.empty(); });
+            task = queue->tasks.front();
+            queue->tasks.pop_front();
+        }
+        task->run();
+        TaskGroup *group = task->group;
+        delete task;
+        finish(group);
+    }
+}
+
+// Never freed, as the thread may still be waiting when the program exits
+static BackgroundQueue &background() {
+    static BackgroundQueue *queue = [] {
+        BackgroundQueue *created = new BackgroundQueue;
+        std::thread(run_background, created).detach();
+        return created;
+    }();
+    return *queue;
+}
+
+static void submit_background(Task *task) {
+    BackgroundQueue &queue = background();
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(task);
+    }
+    queue.wake.notify_one();
+}
+
+void spawn_background(TaskGroup &group, std::function<void()> task) {
+    group.pending++;
+    submit_background(new Task{std::move(task), &group});
+}
+
+void spawn_background_detached(std::function<void()> task) {
+    submit_background(new Task{std::move(task), nullptr});
+}
+
+void wait(TaskGroup &group) {
+    if (self_pool) {
+        while (group.pending.load(std::memory_order_acquire) != 0) {
+            Task *task = find_task(*self_pool, self_index);
+            if (task)
+                execute(*self_pool, task);
+            else
+                std::this_thread::yield();
+        }
+    }
+    std::unique_lock<std::mutex> guard(group.lock);
+    group.done.wait(guard, [&] { return group.pending.load() == 0; });
+}
+
+struct RangeJob {
+    const std::function<void(size_t, size_t)> &body;
+    size_t grain;
+    TaskGroup group{};
+};
+
+// Halves [lo, hi) while the depth allows, handing the upper halves to the
+// pool, and runs the chunks of what is left
+static void run_range(RangeJob &job, size_t lo, size_t hi, uint32_t depth) {
+    size_t grain = job.grain;
+    while (depth > 0 && hi - lo > grain) {
+        size_t chunks = (hi - lo + grain - 1) / grain;
+        size_t mid = lo + chunks / 2 * grain;
+        Worker *owner = self;
+        spawn(job.group, [&job, mid, hi, depth, owner]() {
+            run_range(job, mid, hi,
+                      depth - 1 + (self != owner ? STEAL_SPLITS : 0));
+        });
+        hi = mid;
+        depth--;
+    }
+    for (size_t from = lo; from < hi; from += grain)
+        job.body(from, std::min(hi, from + grain));
+}
+
+void parallel_for(size_t begin, size_t end,
+                  const std::function<void(size_t, size_t)> &body,
+                  size_t grain) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+    size_t chunks = (end - begin + grain - 1) / grain;
+    size_t threads = std::min<size_t>(worker_count(), chunks);
+    if (threads <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    Pool &p = get_pool();
+    RangeJob job{body, grain};
+    uint32_t depth = PARALLEL_SPLIT_DEPTH;
+    for (size_t t = 1; t < threads; t *= 2) depth++;
+
+    if (self_pool) {
+        run_range(job, begin, end, depth);
+    } else if (p.numa) {
+        // every node gets its slice, starting on a chunk boundary
+        auto align = [&](size_t index) {
+            size_t chunk = (index - begin + grain - 1) / grain;
+            return std::min(end, begin + chunk * grain);
+        };
+        for (uint32_t k = 0; k < p.injected.size(); k++) {
+            size_t from, to;
+            numa_slice(begin, end, k, threads, from, to);
+            from = align(from);
+            to = align(to);
+            if (from >= to) continue;
+            job.group.pending++;
+            submit(p, new Task{[&job, from, to, depth]() {
+                                   run_range(job, from, to, depth);
+                               },
+                               &job.group},
+                   k);
+        }
+    } else {
+        job.group.pending++;
+        submit(p, new Task{[&job, begin, end, depth]() {
+                               run_range(job, begin, end, depth);
+                           },
+                           &job.group},
+               0);
+    }
+    wait(job.group);
+}
+
+std::vector<WorkerStats> worker_stats() {
+    std::lock_guard<std::mutex> guard(pool_lock);
+    std::vector<WorkerStats> stats;
+    if (pool == nullptr) return stats;
+    double elapsed = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - pool->since)
+                         .count();
+    for (auto &worker : pool->workers) {
+        WorkerStats entry;
+        entry.tasks = worker->tasks.load();
+        entry.steals = worker->steals.load();
+        entry.busy_ms = worker->busy_ns.load() / 1e6;
+        entry.utilization = elapsed > 0 ? entry.busy_ms / elapsed : 0;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+void reset_worker_stats() {
+    std::lock_guard<std::mutex> guard(pool_lock);
+    if (pool == nullptr) return;
+    for (auto &worker : pool->workers) {
+        worker->tasks.store(0);
+        worker->steals.store(0);
+        worker->busy_ns.store(0);
+    }
+    pool->since = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,153 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Parallel work runs on one pool of worker threads, started on first use.
+// Every worker keeps its tasks in a Chase-Lev deque: it pushes and pops at
+// one end, and idle workers steal from the other. Tasks spawned by threads
+// outside the pool go through a shared queue instead. Long blocking jobs go
+// to a separate queue served by a background thread, which workers waiting
+// for a group never take tasks from.
+
+/**
+ * @brief A set of tasks that can be waited for together.
+ */
+struct TaskGroup {
+    std::atomic<uint64_t> pending{0};  ///< Tasks spawned and not finished.
+    std::mutex lock;                   ///< Guards the end of the last task.
+    std::condition_variable done;      ///< Signaled when none is pending.
+};
+
+/**
+ * @brief How much one worker of the pool has done.
+ */
+struct WorkerStats {
+    uint64_t tasks = 0;        ///< Tasks run.
+    uint64_t steals = 0;       ///< Tasks taken from other workers.
+    double busy_ms = 0;        ///< Time spent running tasks.
+    double utilization = 0;    ///< Share of the elapsed time spent busy.
+};
+
+/**
+ * @brief Returns the number of threads parallel loops are spread over.
+ * @return uint32_t The configured count, by default the number of hardware
+ * threads, at least 1.
+ */
+uint32_t worker_count();
+
+/**
+ * @brief Sets the number of threads parallel loops are spread over.
+ *
+ * The pool is restarted with the new size by the next parallel loop
+ * started while no task is running.
+ * @param count Number of threads, 0 to go back to the hardware default.
+ */
+void set_worker_count(uint32_t count);
+
+/**
+ * @brief Runs a task on the pool as part of a group.
+ * @param group The group the task belongs to.
+ * @param task  The task.
+ */
+void spawn(TaskGroup &group, std::function<void()> task);
+
+/**
+ * @brief Runs a task on the pool without waiting for it.
+ * @param task The task.
+ */
+void spawn_detached(std::function<void()> task);
+
+/**
+ * @brief Runs a long blocking job on the background thread as part of a
+ * group.
+ *
+ * Jobs run one at a time in the order they were spawned, so a worker
+ * helping in wait() never ends up running one.
+ * @param group The group the job belongs to.
+ * @param task  The job.
+ */
+void spawn_background(TaskGroup &group, std::function<void()> task);
+
+/**
+ * @brief Runs a long blocking job on the background thread without waiting
+ * for it.
+ * @param task The job.
+ */
+void spawn_background_detached(std::function<void()> task);
+
+/**
+ * @brief Waits for every task of a group to finish.
+ *
+ * Workers of the pool run other tasks while they wait; other threads block.
+ * @param group The group.
+ */
+void wait(TaskGroup &group);
+
+/**
+ * @brief Runs a loop body over [begin, end) split across worker threads.
+ *
+ * The range is cut into chunks of `grain` indices. Chunks always start at
+ * `begin` plus a multiple of `grain`. The range is halved into tasks a few
+ * times per worker, and a piece stolen by another worker is halved further,
+ * so ranges whose chunks have uneven amounts of work keep being divided
+ * where the work is.
+ *
+ * In NUMA mode (see set_numa_mode()) every node first takes the chunks of
+ * its own slice of the range, given by numa_slice(), and workers are
+ * pinned to the CPUs of their node.
+ *
+ * @param begin First index of the range.
+ * @param end   One past the last index of the range.
+ * @param body  Called with the bounds [from, to) of each chunk.
+ * @param grain Number of indices per chunk.
+ */
+void parallel_for(size_t begin, size_t end,
+                  const std::function<void(size_t, size_t)> &body,
+                  size_t grain = 1024);
+
+/**
+ * @brief Returns what every worker of the pool has done since the pool
+ * started or the last call to reset_worker_stats().
+ * @return std::vector<WorkerStats> One entry per worker, empty before the
+ * pool starts.
+ */
+std::vector<WorkerStats> worker_stats();
+
+/**
+ * @brief Starts counting worker statistics from zero.
+ */
+void reset_worker_stats();
+
+#endif  // PARALLEL_H_
@@ -0,0 +1,237 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Adjacency.h"
+#include "Csr.h"
+#include "Reorder.h"
+#include "Structures.h"
+
+#define NO_ID UINT32_MAX
+
+static uint64_t degree(const CsrGraph &csr, uint32_t v) {
+    return csr.out_offsets[v + 1] - csr.out_offsets[v] + csr.in_offsets[v + 1] -
+           csr.in_offsets[v];
+}
+
+// Calls visit(u) for every parent and child u of v
+template <typename Visit>
+static void for_each_neighbor(const CsrGraph &csr, uint32_t v, Visit visit) {
+    for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1]; e++)
+        visit(csr.out_targets[e]);
+    for (uint64_t e = csr.in_offsets[v]; e < csr.in_offsets[v + 1]; e++)
+        visit(csr.in_sources[e]);
+}
+
+// Appends the vertices reachable from `start` that are not yet in `order`,
+// in breadth-first order; with `by_degree` the new neighbors of every
+// vertex are appended by increasing degree
+static void append_bfs(const CsrGraph &csr, uint32_t start, bool by_degree,
+                       std::vector<uint8_t> &seen,
+                       std::vector<uint32_t> &order) {
+    size_t head = order.size();
+    order.push_back(start);
+    seen[start] = 1;
+    for (; head < order.size(); head++) {
+        size_t first = order.size();
+        for_each_neighbor(csr, order[head], [&](uint32_t u) {
+            if (seen[u]) return;
+            seen[u] = 1;
+            order.push_back(u);
+        });
+        if (by_degree) {
+            std::sort(order.begin() + first, order.end(),
+                      [&](uint32_t a, uint32_t b) {
+                          return degree(csr, a) < degree(csr, b);
+                      });
+        }
+    }
+}
+
+// Starting from `start`, finds a vertex of low degree in the last level of
+// a breadth-first search, one step of the George-Liu pseudo-peripheral
+// search
+static uint32_t peripheral(const CsrGraph &csr, uint32_t start,
+                           std::vector<uint32_t> &level) {
+    std::vector<uint32_t> queue(1, start), touched(1, start);
+    level[start] = 0;
+    uint32_t best = start;
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t v = queue[head];
+        if (level[v] > level[best] ||
+            (level[v] == level[best] && degree(csr, v) < degree(csr, best)))
+            best = v;
+        for_each_neighbor(csr, v, [&](uint32_t u) {
+            if (level[u] != NO_ID) return;
+            level[u] = level[v] + 1;
+            queue.push_back(u);
+        });
+    }
+    for (uint32_t v : queue) level[v] = NO_ID;
+    return best;
+}
+
+std::vector<uint32_t> reorder_permutation(const CsrGraph &csr,
+                                          uint32_t method) {
+    uint32_t n = csr.n;
+    std::vector<uint32_t> by_degree;
+    for (uint32_t v = 0; v < n; v++) {
+        if (csr.present[v]) by_degree.push_back(v);
+    }
+    std::stable_sort(by_degree.begin(), by_degree.end(),
+                     [&](uint32_t a, uint32_t b) {
+                         return degree(csr, a) > degree(csr, b);
+                     });
+
+    std::vector<uint32_t> order;
+    order.reserve(by_degree.size());
+    if (method == REORDER_DEGREE) {
+        order = by_degree;
+    } else if (method == REORDER_BFS) {
+        std::vector<uint8_t> seen(n, 0);
+        for (uint32_t v : by_degree) {
+            if (!seen[v]) append_bfs(csr, v, false, seen, order);
+        }
+    } else {
+        // components are started from their lowest-degree vertex
+        std::vector<uint8_t> seen(n, 0);
+        std::vector<uint32_t> level(n, NO_ID);
+        for (auto it = by_degree.rbegin(); it != by_degree.rend(); it++) {
+            if (seen[*it]) continue;
+            append_bfs(csr, peripheral(csr, *it, level), true, seen, order);
+        }
+        std::reverse(order.begin(), order.end());
+    }
+
+    std::vector<uint32_t> permutation(n, NO_ID);
+    for (uint32_t i = 0; i < order.size(); i++) permutation[order[i]] = i;
+    return permutation;
+}
+
+double mean_log_gap(const CsrGraph &csr) {
+    if (csr.m == 0) return 0;
+    double sum = 0;
+    for (uint32_t v = 0; v < csr.n; v++) {
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            sum += std::log2(static_cast<double>(u > v ? u - v : v - u) + 1);
+        }
+    }
+    return sum / csr.m;
+}
+
+// Moves every list to the slot of its vertex's new ID and renumbers its
+// entries, copying the lists still shared with a fork. Map nodes are moved
+// rather than reallocated.
+static void renumber(AdjacencyMap &layers,
+                     const std::vector<uint32_t> &permutation) {
+    AdjacencyMap::Table &map = layers.flat();
+    AdjacencyMap::Table renumbered;
+    renumbered.reserve(map.size());
+    while (!map.empty()) {
+        auto node = map.extract(map.begin());
+        uint32_t *list = writable_list(node.mapped());
+        for (uint32_t j = 1; j <= list[0]; j++)
+            list[j] = permutation[list[j]];
+        node.key() = permutation[node.key()];
+        renumbered.insert(std::move(node));
+    }
+    map.swap(renumbered);
+}
+
+std::vector<uint32_t> reorder_graph(Graph &graph, uint32_t method) {
+    std::vector<uint32_t> permutation =
+        reorder_permutation(*get_csr(graph), method);
+
+    // IDs not in use follow the vertices, so every ID the manager may hand
+    // out again has a place
+    IdManager &manager = *graph.manager;
+    uint32_t n = std::max(manager.max_vertex,
+                          static_cast<uint32_t>(permutation.size()));
+    if (graph.ids) {
+        n = std::max(n, static_cast<uint32_t>(graph.ids->internal.size()));
+    }
+    uint32_t next = static_cast<uint32_t>(
+        permutation.size() -
+        std::count(permutation.begin(), permutation.end(), NO_ID));
+    permutation.resize(n, NO_ID);
+    for (uint32_t &id : permutation) {
+        if (id == NO_ID) id = next++;
+    }
+
+    renumber(*graph.outbound, permutation);
+    renumber(*graph.inbound, permutation);
+
+    CostMap::Table &costs = graph.costs->flat();
+    CostMap::Table renumbered;
+    renumbered.reserve(costs.size());
+    while (!costs.empty()) {
+        auto node = costs.extract(costs.begin());
+        node.key() = {permutation[node.key().first],
+                      permutation[node.key().second]};
+        renumbered.insert(std::move(node));
+    }
+    costs.swap(renumbered);
+
+    // the graph file IDs stay, only the internal IDs they map to change
+    for (auto &entry : manager.map.flat())
+        entry.second = permutation[entry.second];
+    for (uint32_t &id : manager.unused_ids) id = permutation[id];
+    manager.max_vertex = n;
+
+    // and so do the IDs clients use
+    std::shared_ptr<IdTranslation> ids = std::make_shared<IdTranslation>();
+    ids->internal.resize(n);
+    ids->client.resize(n);
+    for (uint32_t id = 0; id < n; id++) {
+        uint32_t moved = permutation[internal_id(graph.ids.get(), id)];
+        ids->internal[id] = moved;
+        ids->client[moved] = id;
+    }
+    graph.ids = ids;
+
+    graph.csr.reset();
+    graph.landmarks.reset();
+    graph.hierarchy.reset();
+    graph.connectivity.reset();
+    return permutation;
+}
+
+uint32_t internal_id(const IdTranslation *ids, uint32_t id) {
+    if (ids == nullptr || id >= ids->internal.size()) return id;
+    return ids->internal[id];
+}
+
+uint32_t client_id(const IdTranslation *ids, uint32_t id) {
+    if (ids == nullptr || id >= ids->client.size()) return id;
+    return ids->client[id];
+}
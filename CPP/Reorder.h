@@ -0,0 +1,101 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef REORDER_H_
+#define REORDER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+// Orders the vertices can be renumbered in
+#define REORDER_DEGREE 1  ///< By decreasing degree, hubs first.
+#define REORDER_BFS 2     ///< Breadth-first from the highest-degree vertex.
+#define REORDER_RCM 3     ///< Reverse Cuthill-McKee.
+
+/**
+ * @brief Computes a renumbering of the vertices that keeps neighbors close.
+ *
+ * Edges are followed in both directions. Breadth-first and reverse
+ * Cuthill-McKee orders go through the components one after the other; the
+ * latter starts each component from a vertex far from its center, takes the
+ * neighbors of a vertex by increasing degree and reverses the result, which
+ * keeps the gap between the IDs of neighbors small. Vertex IDs not in use
+ * get no new ID, so the new IDs are 0, 1, ... without holes.
+ *
+ * @param csr    The graph.
+ * @param method One of REORDER_DEGREE, REORDER_BFS and REORDER_RCM.
+ * @return std::vector<uint32_t> New ID of every vertex, UINT32_MAX for IDs
+ * not in use.
+ */
+std::vector<uint32_t> reorder_permutation(const CsrGraph &csr,
+                                          uint32_t method);
+
+/**
+ * @brief Measures how far apart the IDs of neighbors are.
+ * @param csr The graph.
+ * @return double The mean of log2(|u - v| + 1) over the edges (u, v).
+ */
+double mean_log_gap(const CsrGraph &csr);
+
+/**
+ * @brief Renumbers the vertices of a graph to improve memory locality.
+ *
+ * Rewrites the adjacency lists, the edge weights and the ID manager so that
+ * internal ID v becomes `permutation[v]`. IDs not in use are moved after
+ * the vertices, so the permutation covers every ID below the manager's
+ * highest and stays one to one. Clients keep the IDs they used before:
+ * the graph's translation is updated, and internal_id() and client_id()
+ * convert at the boundary. The IDs of the graph file, which delta files and
+ * saved landmark tables and hierarchies use, keep naming the same vertices
+ * as well. The landmark table, the hierarchy and the connectivity index are
+ * dropped.
+ *
+ * @param graph  The graph.
+ * @param method One of REORDER_DEGREE, REORDER_BFS and REORDER_RCM.
+ * @return std::vector<uint32_t> New internal ID of every internal ID.
+ * @note Call begin_mutation() on the graph first.
+ */
+std::vector<uint32_t> reorder_graph(Graph &graph, uint32_t method);
+
+/**
+ * @brief Converts a vertex ID given by a client to an internal ID.
+ * @param ids The graph's translation, null if it was never reordered.
+ * @param id  The client ID.
+ * @return uint32_t The internal ID, `id` itself past the translated range.
+ */
+uint32_t internal_id(const IdTranslation *ids, uint32_t id);
+
+/**
+ * @brief Converts an internal vertex ID to the ID clients use.
+ * @param ids The graph's translation, null if it was never reordered.
+ * @param id  The internal ID.
+ * @return uint32_t The client ID, `id` itself past the translated range.
+ */
+uint32_t client_id(const IdTranslation *ids, uint32_t id);
+
+#endif  // REORDER_H_
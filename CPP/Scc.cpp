@@ -0,0 +1,317 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Csr.h"
+#include "Data.h"
+#include "Parallel.h"
+#include "Scc.h"
+#include "Structures.h"
+
+#define UNASSIGNED UINT32_MAX
+// Trimming stops once a pass removes fewer than 1/TRIM_RATIO of the
+// vertices; long chains are left to the coloring phase instead of costing
+// one pass per vertex
+#define TRIM_RATIO 100
+
+// Renumbers arbitrary component labels to 0, 1, ... by lowest vertex
+static uint32_t normalize(std::vector<uint32_t> &comp) {
+    std::vector<uint32_t> remap(comp.size(), UNASSIGNED);
+    uint32_t count = 0;
+    for (uint32_t &label : comp) {
+        if (label == UNASSIGNED) continue;
+        if (remap[label] == UNASSIGNED) remap[label] = count++;
+        label = remap[label];
+    }
+    return count;
+}
+
+std::vector<uint32_t> scc_tarjan(const CsrGraph &csr, uint32_t &count) {
+    uint32_t n = csr.n;
+    std::vector<uint32_t> index(n, UNASSIGNED), low(n, 0), comp(n, UNASSIGNED);
+    std::vector<uint8_t> on_stack(n, 0);
+    std::vector<uint32_t> stack;
+    // explicit call stack: the vertex and the next outbound edge to visit
+    std::vector<std::pair<uint32_t, uint64_t>> calls;
+    uint32_t counter = 0, components = 0;
+
+    auto visit = [&](uint32_t v) {
+        index[v] = low[v] = counter++;
+        stack.push_back(v);
+        on_stack[v] = 1;
+        calls.emplace_back(v, csr.out_offsets[v]);
+    };
+
+    for (uint32_t s = 0; s < n; s++) {
+        if (!csr.present[s] || index[s] != UNASSIGNED) continue;
+        visit(s);
+        while (!calls.empty()) {
+            uint32_t v = calls.back().first;
+            uint64_t e = calls.back().second;
+            if (e < csr.out_offsets[v + 1]) {
+                calls.back().second++;
+                uint32_t u = csr.out_targets[e];
+                if (index[u] == UNASSIGNED)
+                    visit(u);
+                else if (on_stack[u])
+                    low[v] = std::min(low[v], index[u]);
+                continue;
+            }
+
+            if (low[v] == index[v]) {
+                uint32_t w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = 0;
+                    comp[w] = components;
+                } while (w != v);
+                components++;
+            }
+            calls.pop_back();
+            if (!calls.empty()) {
+                uint32_t parent = calls.back().first;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+        }
+    }
+    count = normalize(comp);
+    return comp;
+}
+
+// Parallel level-synchronous search from `start` over vertices that have no
+// component yet
+static std::vector<std::atomic<uint8_t>> reach(
+    const CsrGraph &csr, uint32_t start, bool forward,
+    const std::vector<uint32_t> &comp) {
+    const std::vector<uint64_t> &offsets =
+        forward ? csr.out_offsets : csr.in_offsets;
+    const std::vector<uint32_t> &targets =
+        forward ? csr.out_targets : csr.in_sources;
+    std::vector<std::atomic<uint8_t>> seen(csr.n);
+    for (auto &s : seen) s.store(0, std::memory_order_relaxed);
+    seen[start].store(1);
+
+    std::vector<uint32_t> frontier(1, start), next;
+    std::mutex merge;
+    while (!frontier.empty()) {
+        next.clear();
+        parallel_for(
+            0, frontier.size(),
+            [&](size_t from, size_t to) {
+                std::vector<uint32_t> local;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t v = frontier[i];
+                    for (uint64_t e = offsets[v]; e < offsets[v + 1]; e++) {
+                        uint32_t u = targets[e];
+                        if (comp[u] != UNASSIGNED ||
+                            seen[u].load(std::memory_order_relaxed) ||
+                            seen[u].exchange(1))
+                            continue;
+                        local.push_back(u);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                next.insert(next.end(), local.begin(), local.end());
+            },
+            256);
+        frontier.swap(next);
+    }
+    return seen;
+}
+
+std::vector<uint32_t> scc_parallel(const CsrGraph &csr, uint32_t &count) {
+    uint32_t n = csr.n;
+    // labels are the ID of a representative vertex until normalized
+    std::vector<uint32_t> comp(n, UNASSIGNED);
+    auto active = [&](uint32_t v) {
+        return csr.present[v] && comp[v] == UNASSIGNED;
+    };
+
+    // trim: a vertex without an active parent or child is its own component
+    std::vector<uint8_t> trim(n);
+    while (true) {
+        std::atomic<uint64_t> trimmed(0);
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            uint64_t local = 0;
+            for (size_t v = from; v < to; v++) {
+                trim[v] = 0;
+                if (!active(v)) continue;
+                bool has_in = false, has_out = false;
+                for (uint64_t e = csr.in_offsets[v];
+                     e < csr.in_offsets[v + 1] && !has_in; e++) {
+                    uint32_t u = csr.in_sources[e];
+                    has_in = u != v && active(u);
+                }
+                for (uint64_t e = csr.out_offsets[v];
+                     e < csr.out_offsets[v + 1] && !has_out; e++) {
+                    uint32_t u = csr.out_targets[e];
+                    has_out = u != v && active(u);
+                }
+                if (!has_in || !has_out) {
+                    trim[v] = 1;
+                    local++;
+                }
+            }
+            trimmed += local;
+        });
+        if (trimmed == 0) break;
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            for (size_t v = from; v < to; v++) {
+                if (trim[v]) comp[v] = static_cast<uint32_t>(v);
+            }
+        });
+        if (trimmed < n / TRIM_RATIO) break;
+    }
+
+    // forward-backward from the vertex most likely to be in the giant
+    // component
+    uint32_t pivot = UNASSIGNED;
+    uint64_t best = 0;
+    std::mutex merge;
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        uint32_t local_pivot = UNASSIGNED;
+        uint64_t local_best = 0;
+        for (size_t v = from; v < to; v++) {
+            if (!active(v)) continue;
+            uint64_t score =
+                (csr.in_offsets[v + 1] - csr.in_offsets[v] + 1) *
+                (csr.out_offsets[v + 1] - csr.out_offsets[v] + 1);
+            if (score > local_best) {
+                local_best = score;
+                local_pivot = static_cast<uint32_t>(v);
+            }
+        }
+        std::lock_guard<std::mutex> lock(merge);
+        if (local_best > best || (local_best == best && local_pivot < pivot)) {
+            best = local_best;
+            pivot = local_pivot;
+        }
+    });
+    if (pivot != UNASSIGNED) {
+        std::vector<std::atomic<uint8_t>> fw = reach(csr, pivot, true, comp);
+        std::vector<std::atomic<uint8_t>> bw = reach(csr, pivot, false, comp);
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            for (size_t v = from; v < to; v++) {
+                if (fw[v].load() && bw[v].load()) comp[v] = pivot;
+            }
+        });
+    }
+
+    // coloring for whatever is left
+    std::vector<std::atomic<uint32_t>> color(n);
+    std::vector<uint32_t> remaining, roots;
+    while (true) {
+        remaining.clear();
+        for (uint32_t v = 0; v < n; v++) {
+            if (active(v)) remaining.push_back(v);
+        }
+        if (remaining.empty()) break;
+        for (uint32_t v : remaining) color[v].store(v);
+
+        std::atomic<bool> changed(true);
+        while (changed) {
+            changed = false;
+            parallel_for(0, remaining.size(), [&](size_t from, size_t to) {
+                bool local = false;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t v = remaining[i];
+                    uint32_t c = color[v].load(std::memory_order_relaxed);
+                    for (uint64_t e = csr.out_offsets[v];
+                         e < csr.out_offsets[v + 1]; e++) {
+                        uint32_t u = csr.out_targets[e];
+                        if (!active(u)) continue;
+                        uint32_t old =
+                            color[u].load(std::memory_order_relaxed);
+                        while (c > old &&
+                               !color[u].compare_exchange_weak(old, c))
+                            continue;
+                        local |= c > old;
+                    }
+                }
+                if (local) changed = true;
+            });
+        }
+
+        roots.clear();
+        for (uint32_t v : remaining) {
+            if (color[v].load() == v) roots.push_back(v);
+        }
+        // colors are disjoint, so every root's search touches its own
+        // vertices only
+        parallel_for(
+            0, roots.size(),
+            [&](size_t from, size_t to) {
+                std::vector<uint32_t> queue;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t root = roots[i];
+                    queue.assign(1, root);
+                    comp[root] = root;
+                    while (!queue.empty()) {
+                        uint32_t v = queue.back();
+                        queue.pop_back();
+                        for (uint64_t e = csr.in_offsets[v];
+                             e < csr.in_offsets[v + 1]; e++) {
+                            uint32_t u = csr.in_sources[e];
+                            if (color[u].load(std::memory_order_relaxed) !=
+                                    root ||
+                                !active(u))
+                                continue;
+                            comp[u] = root;
+                            queue.push_back(u);
+                        }
+                    }
+                }
+            },
+            1);
+    }
+
+    count = normalize(comp);
+    return comp;
+}
+
+uint32_t *get_components(Graph &graph, uint32_t *list_of_vertices,
+                         uint32_t &count) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<uint32_t> comp = worker_count() > 1
+                                     ? scc_parallel(*csr, count)
+                                     : scc_tarjan(*csr, count);
+
+    uint32_t *result = new uint32_t[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < comp.size() ? comp[v] : UNASSIGNED;
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
@@ -0,0 +1,78 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SCC_H_
+#define SCC_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+// Both algorithms return an array indexed by internal vertex ID holding the
+// ID of the vertex's strongly connected component. Component IDs are
+// numbered 0, 1, ... in the order of their lowest vertex, so both algorithms
+// give identical arrays; IDs not in use get UINT32_MAX.
+
+/**
+ * @brief Finds strongly connected components with Tarjan's algorithm.
+ *
+ * The depth-first search keeps its own stack instead of recursing, so deep
+ * graphs cannot overflow the call stack.
+ *
+ * @param csr   The graph.
+ * @param count Set to the number of components.
+ * @return std::vector<uint32_t> Component ID of every vertex.
+ */
+std::vector<uint32_t> scc_tarjan(const CsrGraph &csr, uint32_t &count);
+
+/**
+ * @brief Finds strongly connected components in parallel.
+ *
+ * Trims vertices without active parents or children, peels the component of
+ * a high-degree pivot with a forward and a backward search, and splits the
+ * rest by coloring: every vertex takes the highest ID that reaches it, and
+ * each color's root collects its component with a backward search over
+ * vertices of that color.
+ *
+ * @param csr   The graph.
+ * @param count Set to the number of components.
+ * @return std::vector<uint32_t> Component ID of every vertex.
+ */
+std::vector<uint32_t> scc_parallel(const CsrGraph &csr, uint32_t &count);
+
+/**
+ * @brief Retrieves the strongly connected component of a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param list_of_vertices Pointer to the list of vertices.
+ * @param count            Set to the number of components of the graph.
+ * @return uint32_t* Dynamically allocated array with the number of vertices
+ * in the first cell and their component IDs after it.
+ */
+uint32_t *get_components(Graph &graph, uint32_t *list_of_vertices,
+                         uint32_t &count);
+
+#endif  // SCC_H_
@@ -0,0 +1,203 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Csr.h"
+#include "Data.h"
+#include "Hierarchy.h"
+#include "Landmarks.h"
+#include "Metrics.h"
+#include "Parallel.h"
+#include "ShortestPath.h"
+#include "Structures.h"
+
+std::vector<uint64_t> dijkstra(const CsrGraph &csr, uint32_t source,
+                               uint32_t target,
+                               std::vector<uint32_t> *parents) {
+    std::vector<uint64_t> dist(csr.n, UNREACHABLE);
+    if (parents) parents->assign(csr.n, UINT32_MAX);
+    if (source >= csr.n || !csr.present[source]) return dist;
+
+    RadixHeap heap;
+    dist[source] = 0;
+    heap.push(0, source);
+    while (heap.size) {
+        std::pair<uint64_t, uint32_t> top = heap.pop();
+        uint32_t v = top.second;
+        if (top.first != dist[v]) continue;  // stale entry
+        if (v == target) break;
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            uint64_t candidate = top.first + csr.out_weights[e];
+            if (candidate < dist[u]) {
+                dist[u] = candidate;
+                if (parents) (*parents)[u] = v;
+                heap.push(candidate, u);
+            }
+        }
+    }
+    return dist;
+}
+
+std::vector<uint64_t> delta_stepping(const CsrGraph &csr, uint32_t source,
+                                     uint64_t delta) {
+    uint32_t n = csr.n;
+    std::vector<uint64_t> result(n, UNREACHABLE);
+    if (source >= n || !csr.present[source]) return result;
+
+    if (delta == 0) {
+        // Meyer and Sanders: a width of max weight / average degree keeps
+        // re-relaxations low on random graphs
+        uint64_t max_weight = 1;
+        for (uint32_t w : csr.out_weights)
+            max_weight = std::max<uint64_t>(max_weight, w);
+        uint64_t degree = std::max<uint64_t>(1, csr.m / std::max(1u, n));
+        delta = std::max<uint64_t>(1, max_weight / degree);
+    }
+
+    std::vector<std::atomic<uint64_t>> dist(n);
+    for (auto &d : dist) d.store(UNREACHABLE, std::memory_order_relaxed);
+    dist[source].store(0);
+
+    std::vector<std::vector<uint32_t>> buckets(1, {source});
+    std::mutex merge;
+
+    // relaxes the light or the heavy edges of `vertices` in parallel and
+    // files every improved vertex into its new bucket
+    auto relax = [&](const std::vector<uint32_t> &vertices, bool light) {
+        std::vector<uint32_t> improved;
+        parallel_for(
+            0, vertices.size(),
+            [&](size_t from, size_t to) {
+                std::vector<uint32_t> local;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t v = vertices[i];
+                    uint64_t base = dist[v].load(std::memory_order_relaxed);
+                    for (uint64_t e = csr.out_offsets[v];
+                         e < csr.out_offsets[v + 1]; e++) {
+                        if ((csr.out_weights[e] <= delta) != light) continue;
+                        uint32_t u = csr.out_targets[e];
+                        uint64_t candidate = base + csr.out_weights[e];
+                        uint64_t old =
+                            dist[u].load(std::memory_order_relaxed);
+                        while (candidate < old &&
+                               !dist[u].compare_exchange_weak(old, candidate))
+                            continue;
+                        if (candidate < old) local.push_back(u);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                improved.insert(improved.end(), local.begin(), local.end());
+            },
+            256);
+        for (uint32_t u : improved) {
+            size_t b = dist[u].load(std::memory_order_relaxed) / delta;
+            if (b >= buckets.size()) buckets.resize(b + 1);
+            buckets[b].push_back(u);
+        }
+    };
+
+    for (size_t i = 0; i < buckets.size(); i++) {
+        std::vector<uint32_t> settled;
+        while (!buckets[i].empty()) {
+            std::vector<uint32_t> current;
+            current.swap(buckets[i]);
+            std::sort(current.begin(), current.end());
+            current.erase(std::unique(current.begin(), current.end()),
+                          current.end());
+            // drop vertices that have since moved to a lower distance
+            // than this bucket's entries were filed with
+            current.erase(
+                std::remove_if(current.begin(), current.end(),
+                               [&](uint32_t v) {
+                                   return dist[v].load() / delta != i;
+                               }),
+                current.end());
+            settled.insert(settled.end(), current.begin(), current.end());
+            relax(current, true);
+        }
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()),
+                      settled.end());
+        relax(settled, false);
+    }
+
+    for (uint32_t v = 0; v < n; v++) result[v] = dist[v].load();
+    return result;
+}
+
+uint64_t *get_distances(Graph &graph, uint32_t source,
+                        uint32_t *list_of_vertices) {
+    OperationTimer timer(OPERATION_DISTANCES);
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    // a single thread is faster with a heap than with buckets
+    std::vector<uint64_t> dist = worker_count() > 1
+                                     ? delta_stepping(*csr, source)
+                                     : dijkstra(*csr, source);
+
+    uint64_t *result = new uint64_t[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < dist.size() ? dist[v] : UNREACHABLE;
+        i++;
+    }
+    result[0] = i;
+    timer.items = i;
+    return result;
+}
+
+std::vector<uint32_t> get_shortest_path(Graph &graph, uint32_t source,
+                                        uint32_t target, uint64_t &distance) {
+    OperationTimer timer(OPERATION_SHORTEST_PATH);
+    timer.items = 1;
+    std::vector<uint32_t> path;
+    if (graph.hierarchy) {
+        distance = ch_query(*graph.hierarchy, source, target, &path);
+        return path;
+    }
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    if (graph.landmarks) {
+        distance = alt_query(*csr, *graph.landmarks, source, target, &path);
+        return path;
+    }
+
+    std::vector<uint32_t> parents;
+    std::vector<uint64_t> dist = dijkstra(*csr, source, target, &parents);
+
+    distance = target < dist.size() ? dist[target] : UNREACHABLE;
+    if (distance == UNREACHABLE) return path;
+    for (uint32_t v = target; v != UINT32_MAX; v = parents[v])
+        path.push_back(v);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,145 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SHORTESTPATH_H_
+#define SHORTESTPATH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/// Distance of vertices that cannot be reached.
+const uint64_t UNREACHABLE = UINT64_MAX;
+
+/**
+ * @brief Monotone priority queue for integer keys.
+ *
+ * An element lives in the bucket named by the highest bit in which its key
+ * differs from the last popped key, so pops only ever redistribute one
+ * bucket into lower ones. Keys pushed must not be below `last`.
+ */
+struct RadixHeap {
+    std::vector<std::pair<uint64_t, uint32_t>> buckets[65];
+    uint64_t last = 0;  ///< The last popped key.
+    size_t size = 0;    ///< Number of elements queued.
+
+    static int bucket_of(uint64_t key, uint64_t last) {
+        return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+    }
+
+    void push(uint64_t key, uint32_t vertex) {
+        buckets[bucket_of(key, last)].emplace_back(key, vertex);
+        size++;
+    }
+
+    std::pair<uint64_t, uint32_t> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            last = UINT64_MAX;
+            for (const auto &entry : buckets[i])
+                last = std::min(last, entry.first);
+            for (const auto &entry : buckets[i])
+                buckets[bucket_of(entry.first, last)].push_back(entry);
+            buckets[i].clear();
+        }
+        std::pair<uint64_t, uint32_t> top = buckets[0].back();
+        buckets[0].pop_back();
+        size--;
+        return top;
+    }
+};
+
+/**
+ * @brief Computes weighted distances from a vertex with Dijkstra's algorithm.
+ *
+ * Uses a monotone radix heap keyed by distance, which is valid because the
+ * edge weights are unsigned, and reads weights from the CSR copy.
+ *
+ * @param csr     The graph.
+ * @param source  The vertex to start from.
+ * @param target  The search stops once this vertex is settled, UINT32_MAX to
+ * compute the distances to every vertex.
+ * @param parents If not null, filled with the predecessor of every vertex on
+ * its shortest path (UINT32_MAX for the source and unreached vertices).
+ * @return std::vector<uint64_t> Distance to every vertex, UNREACHABLE when
+ * there is no path. With a target, only distances up to the target's are
+ * final.
+ */
+std::vector<uint64_t> dijkstra(const CsrGraph &csr, uint32_t source,
+                               uint32_t target = UINT32_MAX,
+                               std::vector<uint32_t> *parents = nullptr);
+
+/**
+ * @brief Computes weighted distances from a vertex in parallel.
+ *
+ * Delta-stepping: vertices are kept in buckets of width `delta`, and all
+ * vertices of the lowest bucket are relaxed in parallel, first along light
+ * edges (weight <= delta) until the bucket stops refilling, then along heavy
+ * ones.
+ *
+ * @param csr    The graph.
+ * @param source The vertex to start from.
+ * @param delta  Bucket width, 0 to derive it from the average weight and
+ * degree.
+ * @return std::vector<uint64_t> Distance to every vertex, UNREACHABLE when
+ * there is no path.
+ */
+std::vector<uint64_t> delta_stepping(const CsrGraph &csr, uint32_t source,
+                                     uint64_t delta = 0);
+
+/**
+ * @brief Retrieves the weighted distances from a vertex to a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param source           The vertex to start from.
+ * @param list_of_vertices Pointer to the list of target vertices.
+ * @return uint64_t* Dynamically allocated array with the number of targets
+ * in the first cell and their distances after it (UNREACHABLE when there is
+ * no path).
+ */
+uint64_t *get_distances(Graph &graph, uint32_t source,
+                        uint32_t *list_of_vertices);
+
+/**
+ * @brief Retrieves a shortest path between two vertices.
+ *
+ * Uses the graph's contraction hierarchy when it has one, A* over its
+ * landmark table when it has that, Dijkstra's algorithm otherwise.
+ *
+ * @param graph    The graph.
+ * @param source   The first vertex of the path.
+ * @param target   The last vertex of the path.
+ * @param distance Set to the length of the path, UNREACHABLE if none exists.
+ * @return std::vector<uint32_t> The vertices of the path, empty if none
+ * exists.
+ */
+std::vector<uint32_t> get_shortest_path(Graph &graph, uint32_t source,
+                                        uint32_t target, uint64_t &distance);
+
+#endif  // SHORTESTPATH_H_
@@ -28,10 +28,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "LayeredMap.h"
+
 /**
  * @brief Represents an edge in a graph, storing parent and child node IDs.
  */
@@ -78,7 +81,9 @@ struct pair_hash {
     std::size_t operator()(const std::pair<T1, T2> &p) const {
         auto h1 = std::hash<T1>{}(p.first);
         auto h2 = std::hash<T2>{}(p.second);
-        return h1 ^ (h2 << 1);  ///< Combines the hashes of the two elements.
+        // spreading the first hash over the whole word keeps pairs of
+        // small IDs from crowding into a few hash values
+        return h1 * 0x9E3779B97F4A7C15ULL ^ h2;
     }
 };
 
@@ -97,6 +102,9 @@ struct vertex_map {
     explicit vertex_map(uint32_t v, uint32_t *l) : vertex(v), list(l) {}
 };
 
+/// Maps the vertex IDs of the graph file to internal IDs.
+typedef LayeredMap<uint32_t, uint32_t> IdMap;
+
 /**
  * @brief Manages vertex IDs, including allocation and reuse of IDs.
  *
@@ -104,9 +112,79 @@ struct vertex_map {
  * management of dynamically changing graphs.
  */
 struct IdManager {
-    std::unordered_map<uint32_t, uint32_t> map;  ///< Maps vertices to IDs.
+    IdMap map;  ///< Maps vertices to IDs.
     std::vector<uint32_t> unused_ids;  ///< Stores IDs that can be reused.
     uint32_t max_vertex = 0;  ///< Tracks the highest assigned vertex ID.
 };
 
+/**
+ * @brief Value policy of the adjacency maps: a map holds one reference to
+ * each list it stores, see Adjacency.h.
+ */
+struct ListSharing {
+    /**
+     * @brief Adds a reference to a list.
+     * @param list The list.
+     * @return uint32_t* The same list.
+     */
+    static uint32_t *share(uint32_t *list);
+
+    /**
+     * @brief Drops a reference to a list.
+     * @param list The list.
+     */
+    static void release(uint32_t *list);
+};
+
+/// Maps each vertex to its adjacency list.
+typedef LayeredMap<uint32_t, uint32_t *, std::hash<uint32_t>, ListSharing>
+    AdjacencyMap;
+
+/// Maps each edge to its weight.
+typedef LayeredMap<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash> CostMap;
+
+/**
+ * @brief Maps the vertex IDs clients use to internal IDs once the graph has
+ * been reordered.
+ *
+ * Both vectors hold inverse permutations of [0, size); IDs from size on
+ * are the same on both sides.
+ */
+struct IdTranslation {
+    std::vector<uint32_t> internal;  ///< Internal ID of each client ID.
+    std::vector<uint32_t> client;    ///< Client ID of each internal ID.
+};
+
+struct CsrGraph;
+struct LandmarkTable;
+struct ContractionHierarchy;
+struct ConnectivityIndex;
+
+/**
+ * @brief Bundles all tables that make up one loaded graph instance.
+ *
+ * Keeping them together allows a new graph to be built on the side and
+ * swapped with the one currently in use. The tables are reference counted so
+ * that forks of a graph can share them; a side that modifies a shared table
+ * stacks its own layer on it, see LayeredMap.
+ * Instances are created with new_graph() or fork_graph().
+ */
+struct Graph {
+    std::shared_ptr<AdjacencyMap> inbound;   ///< Inbound lists.
+    std::shared_ptr<AdjacencyMap> outbound;  ///< Outbound lists.
+    std::shared_ptr<CostMap> costs;          ///< Maps edges to their weights.
+    std::shared_ptr<IdManager> manager;  ///< ID manager of the vertices.
+    uint32_t vertices = 0;               ///< Number of vertices in the graph.
+    uint32_t edges = 0;                  ///< Number of edges in the graph.
+    std::shared_ptr<const CsrGraph> csr;  ///< Cached CSR copy, may be null.
+    /// ALT distance table, null until built or loaded.
+    std::shared_ptr<const LandmarkTable> landmarks;
+    /// Contraction hierarchy, null until built or loaded.
+    std::shared_ptr<const ContractionHierarchy> hierarchy;
+    /// Weak components kept up to date by the mutators, null until used.
+    std::shared_ptr<ConnectivityIndex> connectivity;
+    /// Client IDs of the vertices, null while they are the internal IDs.
+    std::shared_ptr<const IdTranslation> ids;
+};
+
 #endif  // STRUCTURES_H_
@@ -0,0 +1,174 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Csr.h"
+#include "Data.h"
+#include "Parallel.h"
+#include "Structures.h"
+#include "Topo.h"
+
+std::vector<uint32_t> copy_in_degrees(const Graph &graph, uint32_t n) {
+    std::vector<uint32_t> degree(n, 0);
+    for (const auto &entry : *graph.inbound) {
+        if (entry.first < n) degree[entry.first] = entry.second[0];
+    }
+    return degree;
+}
+
+// Every vertex left with a positive in-degree still has a parent that was
+// not emitted, so walking parents through such vertices must run into a
+// vertex it has seen before; the walk from there on is a cycle.
+static void find_cycle(const CsrGraph &csr,
+                       const std::vector<uint32_t> &remaining,
+                       std::vector<uint32_t> &cycle) {
+    cycle.clear();
+    uint32_t start = UINT32_MAX;
+    for (uint32_t v = 0; v < csr.n && start == UINT32_MAX; v++) {
+        if (csr.present[v] && remaining[v] > 0) start = v;
+    }
+    if (start == UINT32_MAX) return;
+
+    std::vector<uint32_t> position(csr.n, UINT32_MAX);
+    std::vector<uint32_t> walk;
+    uint32_t v = start;
+    while (position[v] == UINT32_MAX) {
+        position[v] = static_cast<uint32_t>(walk.size());
+        walk.push_back(v);
+        for (uint64_t e = csr.in_offsets[v]; e < csr.in_offsets[v + 1]; e++) {
+            if (remaining[csr.in_sources[e]] > 0) {
+                v = csr.in_sources[e];
+                break;
+            }
+        }
+    }
+    // the walk follows edges backwards
+    cycle.assign(walk.begin() + position[v], walk.end());
+    std::reverse(cycle.begin(), cycle.end());
+}
+
+std::vector<uint32_t> topological_sort(const CsrGraph &csr,
+                                       std::vector<uint32_t> degree,
+                                       std::vector<uint32_t> *cycle) {
+    std::vector<uint32_t> order;
+    for (uint32_t v = 0; v < csr.n; v++) {
+        if (csr.present[v] && degree[v] == 0) order.push_back(v);
+    }
+    // the result doubles as the queue
+    for (size_t head = 0; head < order.size(); head++) {
+        uint32_t v = order[head];
+        for (uint64_t e = csr.out_offsets[v]; e < csr.out_offsets[v + 1];
+             e++) {
+            uint32_t u = csr.out_targets[e];
+            if (--degree[u] == 0) order.push_back(u);
+        }
+    }
+    if (cycle) find_cycle(csr, degree, *cycle);
+    return order;
+}
+
+std::vector<uint32_t> topological_levels(const CsrGraph &csr,
+                                         std::vector<uint32_t> degree,
+                                         std::vector<uint64_t> &level_starts,
+                                         std::vector<uint32_t> *cycle) {
+    uint32_t n = csr.n;
+    std::vector<std::atomic<uint32_t>> remaining(n);
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++)
+            remaining[v].store(degree[v], std::memory_order_relaxed);
+    });
+
+    std::vector<uint32_t> order, next;
+    for (uint32_t v = 0; v < n; v++) {
+        if (csr.present[v] && degree[v] == 0) order.push_back(v);
+    }
+    level_starts.assign(1, 0);
+    std::mutex merge;
+    size_t begin = 0;
+    while (begin < order.size()) {
+        size_t end = order.size();
+        level_starts.push_back(end);
+        next.clear();
+        parallel_for(
+            begin, end,
+            [&](size_t from, size_t to) {
+                std::vector<uint32_t> local;
+                for (size_t i = from; i < to; i++) {
+                    uint32_t v = order[i];
+                    for (uint64_t e = csr.out_offsets[v];
+                         e < csr.out_offsets[v + 1]; e++) {
+                        uint32_t u = csr.out_targets[e];
+                        if (remaining[u].fetch_sub(1) == 1) local.push_back(u);
+                    }
+                }
+                std::lock_guard<std::mutex> lock(merge);
+                next.insert(next.end(), local.begin(), local.end());
+            },
+            256);
+        std::sort(next.begin(), next.end());
+        order.insert(order.end(), next.begin(), next.end());
+        begin = end;
+    }
+
+    if (cycle) {
+        parallel_for(0, n, [&](size_t from, size_t to) {
+            for (size_t v = from; v < to; v++) degree[v] = remaining[v].load();
+        });
+        find_cycle(csr, degree, *cycle);
+    }
+    return order;
+}
+
+uint32_t *get_topological_levels(Graph &graph, uint32_t *list_of_vertices,
+                                 uint32_t &levels,
+                                 std::vector<uint32_t> &cycle) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::vector<uint64_t> level_starts;
+    std::vector<uint32_t> order = topological_levels(
+        *csr, copy_in_degrees(graph, csr->n), level_starts, &cycle);
+    levels = static_cast<uint32_t>(level_starts.size() - 1);
+
+    std::vector<uint32_t> level(csr->n, UINT32_MAX);
+    for (uint32_t k = 0; k < levels; k++) {
+        for (uint64_t i = level_starts[k]; i < level_starts[k + 1]; i++)
+            level[order[i]] = k;
+    }
+
+    uint32_t *result = new uint32_t[MAX_OPERATON_BUFFER + 1]{0};
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        result[i + 1] = v < level.size() ? level[v] : UINT32_MAX;
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
@@ -0,0 +1,98 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef TOPO_H_
+#define TOPO_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Copies the in-degree of every vertex out of its inbound list.
+ *
+ * @param graph The graph.
+ * @param n     Size of the result, usually the `n` of the graph's CSR copy.
+ * @return std::vector<uint32_t> In-degree of every vertex ID below n, 0 for
+ * IDs not in use.
+ */
+std::vector<uint32_t> copy_in_degrees(const Graph &graph, uint32_t n);
+
+/**
+ * @brief Orders the vertices topologically with Kahn's algorithm.
+ *
+ * Vertices whose in-degree drops to 0 are emitted in turn. If the graph has
+ * a cycle, the vertices on or behind it are never emitted; the result then
+ * holds the acyclic part only and a cycle is reported.
+ *
+ * @param csr    The graph.
+ * @param degree In-degree of every vertex, consumed by the search.
+ * @param cycle  If not null and the graph is not a DAG, filled with the
+ * vertices of one cycle in edge order; left empty otherwise.
+ * @return std::vector<uint32_t> The vertices in topological order.
+ */
+std::vector<uint32_t> topological_sort(const CsrGraph &csr,
+                                       std::vector<uint32_t> degree,
+                                       std::vector<uint32_t> *cycle = nullptr);
+
+/**
+ * @brief Orders the vertices topologically, level by level, in parallel.
+ *
+ * Level 0 holds the vertices without parents and level k + 1 the vertices
+ * whose last parent is on level k. Each level is expanded in parallel with
+ * atomic in-degree counters and sorted, so the result does not depend on
+ * the number of threads.
+ *
+ * @param csr          The graph.
+ * @param degree       In-degree of every vertex, consumed by the search.
+ * @param level_starts Filled with the position in the result where every
+ * level starts, followed by the size of the result.
+ * @param cycle        As for topological_sort().
+ * @return std::vector<uint32_t> The vertices in topological order, grouped
+ * by level.
+ */
+std::vector<uint32_t> topological_levels(
+    const CsrGraph &csr, std::vector<uint32_t> degree,
+    std::vector<uint64_t> &level_starts,
+    std::vector<uint32_t> *cycle = nullptr);
+
+/**
+ * @brief Retrieves the topological level of a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param list_of_vertices Pointer to the list of vertices.
+ * @param levels           Set to the number of levels.
+ * @param cycle            Filled with a cycle if the graph is not a DAG.
+ * @return uint32_t* Dynamically allocated array with the number of vertices
+ * in the first cell and their levels after it (UINT32_MAX for vertices not
+ * in the graph or not ordered because of a cycle).
+ */
+uint32_t *get_topological_levels(Graph &graph, uint32_t *list_of_vertices,
+                                 uint32_t &levels,
+                                 std::vector<uint32_t> &cycle);
+
+#endif  // TOPO_H_
@@ -0,0 +1,252 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Csr.h"
+#include "Data.h"
+#include "Parallel.h"
+#include "Structures.h"
+#include "Triangles.h"
+
+// Lists are galloped instead of merged once one is this many times longer
+#define GALLOP_RATIO 32
+
+// Calls visit(x) for every x in both sorted lists of distinct values
+template <typename Visit>
+static void merge_intersect(const uint32_t *a, size_t na, const uint32_t *b,
+                            size_t nb, Visit visit) {
+    size_t i = 0, j = 0;
+#if defined(__SSE2__)
+    // every entry of a block of a is compared with the four rotations of a
+    // block of b; the block with the lower maximum is consumed
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4e)),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(hits));
+        while (mask) {
+            visit(a[i + __builtin_ctz(mask)]);
+            mask &= mask - 1;
+        }
+        uint32_t a_max = a[i + 3], b_max = b[j + 3];
+        if (a_max <= b_max) i += 4;
+        if (b_max <= a_max) j += 4;
+    }
+#endif
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            visit(a[i]);
+            i++;
+            j++;
+        }
+    }
+}
+
+// Same, for a much shorter than b: every entry of a is searched for by
+// doubling steps from where the previous one was found
+template <typename Visit>
+static void gallop_intersect(const uint32_t *a, size_t na, const uint32_t *b,
+                             size_t nb, Visit visit) {
+    size_t low = 0;
+    for (size_t i = 0; i < na && low < nb; i++) {
+        size_t step = 1, high = low;
+        while (high < nb && b[high] < a[i]) {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+        high = std::min(high + 1, nb);
+        low = std::lower_bound(b + low, b + high, a[i]) - b;
+        if (low < nb && b[low] == a[i]) visit(a[i]);
+    }
+}
+
+template <typename Visit>
+static void intersect(const uint32_t *a, size_t na, const uint32_t *b,
+                      size_t nb, Visit visit) {
+    if (na * GALLOP_RATIO < nb)
+        gallop_intersect(a, na, b, nb, visit);
+    else if (nb * GALLOP_RATIO < na)
+        gallop_intersect(b, nb, a, na, visit);
+    else
+        merge_intersect(a, na, b, nb, visit);
+}
+
+// Calls visit(u) for every neighbor u != v, either direction, once, even
+// across parallel edges
+template <typename Visit>
+static void for_each_neighbor(const CsrGraph &csr, uint32_t v,
+                              Visit visit) {
+    uint64_t i = csr.out_offsets[v], i_end = csr.out_offsets[v + 1];
+    uint64_t j = csr.in_offsets[v], j_end = csr.in_offsets[v + 1];
+    uint32_t last = v;
+    while (i < i_end || j < j_end) {
+        uint32_t u;
+        if (j == j_end || (i < i_end && csr.out_targets[i] < csr.in_sources[j]))
+            u = csr.out_targets[i++];
+        else if (i == i_end || csr.in_sources[j] < csr.out_targets[i])
+            u = csr.in_sources[j++];
+        else  // an edge both ways
+            u = csr.in_sources[j++], i++;
+        // the merged lists are sorted, so repeats are adjacent
+        if (u == last || u == v) continue;
+        last = u;
+        visit(u);
+    }
+}
+
+TriangleCounts count_triangles(const CsrGraph &csr) {
+    uint32_t n = csr.n;
+    TriangleCounts result;
+    result.triangles.assign(n, 0);
+    result.clustering.assign(n, 0);
+
+    std::vector<uint32_t> degree(n, 0);
+    parallel_for(0, n, [&](size_t from, size_t to) {
+        for (size_t v = from; v < to; v++) {
+            uint32_t d = 0;
+            for_each_neighbor(csr, v, [&](uint32_t) { d++; });
+            degree[v] = d;
+        }
+    });
+
+    // rank by degree, ties by ID; the oriented lists hold ranks
+    std::vector<uint32_t> order;
+    for (uint32_t v = 0; v < n; v++) {
+        if (csr.present[v]) order.push_back(v);
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+    });
+    uint32_t count = static_cast<uint32_t>(order.size());
+    std::vector<uint32_t> rank(n, UINT32_MAX);
+    for (uint32_t r = 0; r < count; r++) rank[order[r]] = r;
+
+    std::vector<uint64_t> offsets(count + 1, 0);
+    parallel_for(0, count, [&](size_t from, size_t to) {
+        for (size_t r = from; r < to; r++) {
+            uint32_t higher = 0;
+            for_each_neighbor(csr, order[r], [&](uint32_t u) {
+                higher += rank[u] > r;
+            });
+            offsets[r + 1] = higher;
+        }
+    });
+    for (uint32_t r = 0; r < count; r++) offsets[r + 1] += offsets[r];
+    std::vector<uint32_t> heads(offsets[count]);
+    parallel_for(0, count, [&](size_t from, size_t to) {
+        for (size_t r = from; r < to; r++) {
+            uint64_t at = offsets[r];
+            for_each_neighbor(csr, order[r], [&](uint32_t u) {
+                if (rank[u] > r) heads[at++] = rank[u];
+            });
+            std::sort(heads.begin() + offsets[r], heads.begin() + at);
+        }
+    });
+
+    std::vector<std::atomic<uint64_t>> triangles(count);
+    for (auto &t : triangles) t.store(0, std::memory_order_relaxed);
+    parallel_for(
+        0, count,
+        [&](size_t from, size_t to) {
+            for (size_t r = from; r < to; r++) {
+                const uint32_t *a = heads.data() + offsets[r];
+                size_t na = offsets[r + 1] - offsets[r];
+                uint64_t found = 0;
+                for (size_t k = 0; k < na; k++) {
+                    uint32_t u = a[k];
+                    uint64_t shared = 0;
+                    intersect(a + k + 1, na - k - 1,
+                              heads.data() + offsets[u],
+                              offsets[u + 1] - offsets[u], [&](uint32_t w) {
+                                  shared++;
+                                  triangles[w].fetch_add(
+                                      1, std::memory_order_relaxed);
+                              });
+                    if (shared)
+                        triangles[u].fetch_add(shared,
+                                               std::memory_order_relaxed);
+                    found += shared;
+                }
+                if (found)
+                    triangles[r].fetch_add(found, std::memory_order_relaxed);
+            }
+        },
+        64);
+
+    uint64_t total = 0;
+    double wedges = 0;
+    for (uint32_t r = 0; r < count; r++) {
+        uint32_t v = order[r];
+        uint64_t t = triangles[r].load(std::memory_order_relaxed);
+        double pairs = 0.5 * degree[v] * (degree[v] - 1.0);
+        result.triangles[v] = t;
+        result.clustering[v] = pairs > 0 ? t / pairs : 0;
+        total += t;
+        wedges += pairs;
+    }
+    result.total = total / 3;
+    result.transitivity = wedges > 0 ? 3.0 * result.total / wedges : 0;
+    return result;
+}
+
+uint64_t *get_triangles(Graph &graph, uint32_t *list_of_vertices,
+                        std::vector<double> &clustering, uint64_t &total,
+                        double &transitivity) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    TriangleCounts counts = count_triangles(*csr);
+    total = counts.total;
+    transitivity = counts.transitivity;
+
+    uint64_t *result = new uint64_t[MAX_OPERATON_BUFFER + 1]{0};
+    clustering.clear();
+    uint16_t i = 0;
+    while (i < MAX_OPERATON_BUFFER && list_of_vertices[i] != UINT32_MAX) {
+        uint32_t v = list_of_vertices[i];
+        bool known = v < counts.triangles.size();
+        result[i + 1] = known ? counts.triangles[v] : 0;
+        clustering.push_back(known ? counts.clustering[v] : 0);
+        i++;
+    }
+    result[0] = i;
+    return result;
+}
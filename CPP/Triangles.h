@@ -0,0 +1,82 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef TRIANGLES_H_
+#define TRIANGLES_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Triangles of a graph, with edge directions ignored.
+ */
+struct TriangleCounts {
+    std::vector<uint64_t> triangles;  ///< Triangles through every vertex.
+    std::vector<double> clustering;   ///< Local clustering coefficients.
+    uint64_t total = 0;               ///< Triangles in the graph.
+    double transitivity = 0;          ///< Closed share of all wedges.
+};
+
+/**
+ * @brief Counts triangles and clustering coefficients in parallel.
+ *
+ * Two vertices are neighbors when an edge joins them in either direction;
+ * loops are ignored. Vertices are ranked by degree and every edge is
+ * oriented towards the higher rank, so each triangle is found exactly once
+ * from its lowest vertex by intersecting two oriented lists, and no list
+ * is longer than about sqrt(2m). Lists are intersected by a merge that
+ * compares four entries against four at a time with SSE2 where available,
+ * or by galloping through the longer list when their sizes are far apart.
+ *
+ * The local clustering coefficient of a vertex of degree d with t
+ * triangles is t / (d (d - 1) / 2), 0 below degree 2; transitivity is
+ * 3 * total / number of wedges.
+ *
+ * @param csr The graph.
+ * @return TriangleCounts The counts, indexed by vertex ID.
+ */
+TriangleCounts count_triangles(const CsrGraph &csr);
+
+/**
+ * @brief Retrieves the triangle counts of a set of vertices.
+ *
+ * @param graph            The graph.
+ * @param list_of_vertices Pointer to the list of vertices.
+ * @param clustering       Set to the clustering coefficient of every
+ * listed vertex.
+ * @param total            Set to the number of triangles in the graph.
+ * @param transitivity     Set to the global clustering coefficient.
+ * @return uint64_t* Dynamically allocated array with the number of vertices
+ * in the first cell and their triangle counts after it (0 for vertices not
+ * in the graph).
+ */
+uint64_t *get_triangles(Graph &graph, uint32_t *list_of_vertices,
+                        std::vector<double> &clustering, uint64_t &total,
+                        double &transitivity);
+
+#endif  // TRIANGLES_H_
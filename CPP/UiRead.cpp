@@ -25,18 +25,43 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <random>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "Anf.h"
+#include "Bfs.h"
+#include "Centrality.h"
+#include "Connectivity.h"
+#include "Csr.h"
 #include "Data.h"
+#include "Delta.h"
+#include "Flow.h"
+#include "GraphStore.h"
+#include "Hierarchy.h"
+#include "HwCounters.h"
+#include "Landmarks.h"
+#include "Metrics.h"
+#include "PageRank.h"
+#include "Parallel.h"
+#include "Reorder.h"
+#include "Scc.h"
+#include "ShortestPath.h"
 #include "Structures.h"
+#include "Topo.h"
+#include "Triangles.h"
 #include "UiRead.h"
+#include "Walks.h"
 
-Edge *read_edges() {
+Edge *read_edges(const IdTranslation *ids) {
     uint16_t i = 0;
     Edge *arg_edges =
         reinterpret_cast<Edge *>(malloc(sizeof(Edge) * MAX_OPERATON_BUFFER));
@@ -52,8 +77,8 @@ Edge *read_edges() {
             std::cin >> i2;
             Edge e;
             uint32_t a, b;
-            a = s2i(i1);
-            b = s2i(i2);
+            a = internal_id(ids, s2i(i1));
+            b = internal_id(ids, s2i(i2));
             if (a == UINT32_MAX || b == UINT32_MAX) continue;
             e.parent = a;
             e.child = b;
@@ -64,7 +89,7 @@ Edge *read_edges() {
     return arg_edges;
 }
 
-uint32_t *read_ints() {
+uint32_t *read_ints(const IdTranslation *ids) {
     uint16_t i = 0;
     uint32_t *arg_vertices = reinterpret_cast<uint32_t *>(
         malloc(sizeof(uint32_t) * MAX_OPERATON_BUFFER));
@@ -76,7 +101,7 @@ uint32_t *read_ints() {
         if (sv == "confirm") {
             break;
         }
-        v = s2i(sv);
+        v = internal_id(ids, s2i(sv));
         if (v == UINT32_MAX) continue;
         arg_vertices[i] = v;
         i++;
@@ -93,10 +118,10 @@ int file_exists(const char *filename) {
     return 0;  // File does not exist
 }
 
-void opt2(std::unordered_map<uint32_t, uint32_t *> &outbound) {
+void opt2(AdjacencyMap &outbound, const IdTranslation *ids) {
     std::cout << "Input vertices between you want to check the "
                  "existence of an edge\n";
-    Edge *arg_edges = read_edges();
+    Edge *arg_edges = read_edges(ids);
     int i;
 
     uint8_t *result = check_edges(arg_edges, outbound);
@@ -104,8 +129,8 @@ void opt2(std::unordered_map<uint32_t, uint32_t *> &outbound) {
     std::string found = "exists\n", nfound = "doesn't exist\n";
     std::cout << result[0];
     for (i = 1; i <= result[0]; i++) {
-        std::cout << "Edge " << arg_edges[i - 1].parent << " "
-                  << arg_edges[i - 1].child << " ";
+        std::cout << "Edge " << client_id(ids, arg_edges[i - 1].parent)
+                  << " " << client_id(ids, arg_edges[i - 1].child) << " ";
         if (result[i])
             std::cout << found;
         else
@@ -115,19 +140,19 @@ void opt2(std::unordered_map<uint32_t, uint32_t *> &outbound) {
     delete[] result;
 }
 
-void opt3(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<uint32_t, uint32_t *> &inbound) {
+void opt3(AdjacencyMap &outbound, AdjacencyMap &inbound,
+          const IdTranslation *ids) {
     std::cout << "Insert the vertices for which you want to get the in and out "
                  "degrees\n";
-    uint32_t *arg_vertices = read_ints();
+    uint32_t *arg_vertices = read_ints(ids);
     uint32_t *out_degrees = get_degree(outbound, arg_vertices);
     uint32_t *in_degrees = get_degree(inbound, arg_vertices);
 
     std::cout << "Degrees:\n";
     for (uint16_t i = 1; i <= out_degrees[0]; i++) {
-        std::cout << "Vertex " << arg_vertices[i - 1] << " has out-degree "
-                  << out_degrees[i] << " and in-degree " << in_degrees[i]
-                  << "\n";
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1])
+                  << " has out-degree " << out_degrees[i] << " and in-degree "
+                  << in_degrees[i] << "\n";
     }
 
     free(arg_vertices);
@@ -135,10 +160,10 @@ void opt3(std::unordered_map<uint32_t, uint32_t *> &outbound,
     delete[] in_degrees;
 }
 
-void opt4(std::unordered_map<uint32_t, uint32_t *> &outbound) {
+void opt4(AdjacencyMap &outbound, const IdTranslation *ids) {
     std::cout << "Insert the vertices for which you want to get the out "
                  "connections for\n";
-    uint32_t *arg_vertices = read_ints();
+    uint32_t *arg_vertices = read_ints(ids);
 
     vertex_map *outdegree = get_vertices_connections(outbound, arg_vertices);
     uint16_t sz = (uint16_t)outdegree[0].vertex;
@@ -146,8 +171,10 @@ void opt4(std::unordered_map<uint32_t, uint32_t *> &outbound) {
     for (uint16_t i = 1; i <= sz; i++) {
         uint32_t *list = outdegree[i].list;
         uint32_t sz1 = list[0];
-        std::cout << outdegree[i].vertex << " is connected outwards to: ";
-        for (uint16_t j = 1; j <= sz1; j++) std::cout << list[j] << " ";
+        std::cout << client_id(ids, outdegree[i].vertex)
+                  << " is connected outwards to: ";
+        for (uint16_t j = 1; j <= sz1; j++)
+            std::cout << client_id(ids, list[j]) << " ";
         std::cout << std::endl;
     }
 
@@ -155,10 +182,10 @@ void opt4(std::unordered_map<uint32_t, uint32_t *> &outbound) {
     free(arg_vertices);
 }
 
-void opt5(std::unordered_map<uint32_t, uint32_t *> &inbound) {
+void opt5(AdjacencyMap &inbound, const IdTranslation *ids) {
     std::cout << "Insert the vertices for which you want to get the in "
                  "connections for\n";
-    uint32_t *arg_vertices = read_ints();
+    uint32_t *arg_vertices = read_ints(ids);
 
     vertex_map *indegree = get_vertices_connections(inbound, arg_vertices);
     uint16_t sz = (uint16_t)indegree[0].vertex;
@@ -166,8 +193,10 @@ void opt5(std::unordered_map<uint32_t, uint32_t *> &inbound) {
     for (uint16_t i = 1; i <= sz; i++) {
         uint32_t *list = indegree[i].list;
         uint32_t sz1 = list[0];
-        std::cout << indegree[i].vertex << " is connected inwards to: ";
-        for (uint16_t j = 1; j <= sz1; j++) std::cout << list[j] << " ";
+        std::cout << client_id(ids, indegree[i].vertex)
+                  << " is connected inwards to: ";
+        for (uint16_t j = 1; j <= sz1; j++)
+            std::cout << client_id(ids, list[j]) << " ";
         std::cout << std::endl;
     }
 
@@ -175,27 +204,25 @@ void opt5(std::unordered_map<uint32_t, uint32_t *> &inbound) {
     free(arg_vertices);
 }
 
-void opt6(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs) {
+void opt6(AdjacencyMap &outbound, CostMap &costs, const IdTranslation *ids) {
     std::cout << "Input vertices between which you want to check the weight of "
                  "the edge\n";
-    Edge *arg_edges = read_edges();
+    Edge *arg_edges = read_edges(ids);
 
     uint16_t *result = get_weights_of_edges(arg_edges, outbound, costs);
     uint16_t sz = result[0];
     for (uint16_t i = 0; i < sz; i++) {
-        std::cout << "The weight of the edge (" << arg_edges[i].parent << ", "
-                  << arg_edges[i].child << ") is: " << result[i + 1] << "\n";
+        std::cout << "The weight of the edge ("
+                  << client_id(ids, arg_edges[i].parent) << ", "
+                  << client_id(ids, arg_edges[i].child)
+                  << ") is: " << result[i + 1] << "\n";
     }
 
     free(arg_edges);
     delete[] result;
 }
 
-void opt7(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs) {
+void opt7(AdjacencyMap &outbound, CostMap &costs, const IdTranslation *ids) {
     std::cout << "Input vertices between which you want to change the weight "
                  "of the edge\n";
     std::string i1, i2, i3;
@@ -213,8 +240,8 @@ void opt7(std::unordered_map<uint32_t, uint32_t *> &outbound,
             std::cin >> i2 >> i3;
             Edge e;
             uint32_t a, b, c1;
-            a = s2i(i1);
-            b = s2i(i2);
+            a = internal_id(ids, s2i(i1));
+            b = internal_id(ids, s2i(i2));
             c1 = s2i(i3);
             if (a == UINT32_MAX || b == UINT32_MAX || c1 == UINT32_MAX)
                 continue;
@@ -229,9 +256,9 @@ void opt7(std::unordered_map<uint32_t, uint32_t *> &outbound,
     change_weights_of_edges(arg_edges, weights, outbound, costs);
 }
 
-void opt8(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<uint32_t, uint32_t *> &inbound, IdManager &manager,
-          uint16_t vertex_buffer, uint32_t &Vertices) {
+void opt8(AdjacencyMap &outbound, AdjacencyMap &inbound, IdManager &manager,
+          uint16_t vertex_buffer, uint32_t &Vertices,
+          ConnectivityIndex *connectivity, const IdTranslation *ids) {
     std::cout << "Insert the number of vertices you want to add\n";
     uint32_t v = UINT32_MAX;
     while (v == UINT32_MAX) {
@@ -240,28 +267,29 @@ void opt8(std::unordered_map<uint32_t, uint32_t *> &outbound,
         v = s2i(v1);
     }
     uint32_t *result =
-        add_vertices(v, manager, vertex_buffer, outbound, inbound);
+        add_vertices(v, manager, vertex_buffer, outbound, inbound,
+                     connectivity);
     std::cout << "Added vertices: ";
-    for (uint16_t i = 1; i <= result[0]; i++) std::cout << result[i] << " ";
+    for (uint16_t i = 1; i <= result[0]; i++)
+        std::cout << client_id(ids, result[i]) << " ";
     std::cout << "\n";
     Vertices += result[0];
 
     free(result);
 }
 
-void opt9(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<uint32_t, uint32_t *> &inbound,
-          std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs,
-          IdManager &manager, uint32_t &Vertices) {
+void opt9(AdjacencyMap &outbound, AdjacencyMap &inbound, CostMap &costs,
+          IdManager &manager, uint32_t &Vertices,
+          ConnectivityIndex *connectivity, const IdTranslation *ids) {
     std::cout << "Insert the vertices you want to remove\n";
-    uint32_t *arg_vertices = read_ints();
+    uint32_t *arg_vertices = read_ints(ids);
 
-    uint32_t *result =
-        remove_vertices(arg_vertices, manager, outbound, inbound, costs);
+    uint32_t *result = remove_vertices(arg_vertices, manager, outbound,
+                                       inbound, costs, connectivity);
 
     std::cout << "Removed vertices: ";
-    for (uint16_t i = 1; i <= result[0]; i++) std::cout << result[i] << " ";
+    for (uint16_t i = 1; i <= result[0]; i++)
+        std::cout << client_id(ids, result[i]) << " ";
     std::cout << "\n";
 
     Vertices -= result[0];
@@ -269,11 +297,9 @@ void opt9(std::unordered_map<uint32_t, uint32_t *> &outbound,
     free(result);
 }
 
-void opt10(uint16_t vertex_buffer, uint32_t &Edges,
-           std::unordered_map<uint32_t, uint32_t *> &outbound,
-           std::unordered_map<uint32_t, uint32_t *> &inbound,
-           std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                              pair_hash> &costs) {
+void opt10(uint16_t vertex_buffer, uint32_t &Edges, AdjacencyMap &outbound,
+           AdjacencyMap &inbound, CostMap &costs,
+           ConnectivityIndex *connectivity, const IdTranslation *ids) {
     std::cout << "Insert the edges you want to add (format: vertex1 vertex2 "
                  "weight), type 'confirm' to finish:\n";
 
@@ -294,8 +320,8 @@ void opt10(uint16_t vertex_buffer, uint32_t &Edges,
             std::cin >> i2 >> i3;
             Edge e;
             uint32_t a, b, c1;
-            a = s2i(i1);
-            b = s2i(i2);
+            a = internal_id(ids, s2i(i1));
+            b = internal_id(ids, s2i(i2));
             c1 = s2i(i3);
             if (a == UINT32_MAX || b == UINT32_MAX || c1 == UINT32_MAX)
                 continue;
@@ -307,13 +333,13 @@ void opt10(uint16_t vertex_buffer, uint32_t &Edges,
         }
     }
 
-    uint32_t *result =
-        add_edges(arg_edges, weights, vertex_buffer, outbound, inbound, costs);
+    uint32_t *result = add_edges(arg_edges, weights, vertex_buffer, outbound,
+                                 inbound, costs, connectivity);
 
     std::cout << "Added edges:\n";
     for (uint16_t i = 1; i <= result[0]; i++) {
-        std::cout << "(" << arg_edges[i - 1].parent << ", "
-                  << arg_edges[i - 1].child << ") with weight "
+        std::cout << "(" << client_id(ids, arg_edges[i - 1].parent) << ", "
+                  << client_id(ids, arg_edges[i - 1].child) << ") with weight "
                   << weights[i - 1] << "\n";
     }
 
@@ -324,23 +350,21 @@ void opt10(uint16_t vertex_buffer, uint32_t &Edges,
     delete[] result;
 }
 
-void opt11(uint16_t vertex_buffer, uint32_t &Edges,
-           std::unordered_map<uint32_t, uint32_t *> &outbound,
-           std::unordered_map<uint32_t, uint32_t *> &inbound,
-           std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                              pair_hash> &costs) {
+void opt11(uint16_t vertex_buffer, uint32_t &Edges, AdjacencyMap &outbound,
+           AdjacencyMap &inbound, CostMap &costs,
+           ConnectivityIndex *connectivity, const IdTranslation *ids) {
     std::cout << "Insert the edges you want to remove (format: vertex1 "
                  "vertex2), type 'confirm' to finish:\n";
 
-    Edge *arg_edges = read_edges();
+    Edge *arg_edges = read_edges(ids);
 
-    uint32_t *result =
-        remove_edges(arg_edges, vertex_buffer, outbound, inbound, costs);
+    uint32_t *result = remove_edges(arg_edges, vertex_buffer, outbound,
+                                    inbound, costs, connectivity);
 
     std::cout << "Removed edges:\n";
     for (uint16_t i = 1; i <= result[0]; i++) {
-        std::cout << "(" << arg_edges[i - 1].parent << ", "
-                  << arg_edges[i - 1].child << ")\n";
+        std::cout << "(" << client_id(ids, arg_edges[i - 1].parent) << ", "
+                  << client_id(ids, arg_edges[i - 1].child) << ")\n";
     }
 
     Edges -= result[0];
@@ -348,63 +372,731 @@ void opt11(uint16_t vertex_buffer, uint32_t &Edges,
     delete[] result;
 }
 
-void opt14(std::unordered_map<uint32_t, uint32_t *> &map) {
+void opt14(AdjacencyMap &map, const IdTranslation *ids) {
     auto it = map.begin();
     while (it != map.end()) {
-        std::cout << it->first << "\n";
+        std::cout << client_id(ids, it->first) << "\n";
         it++;
     }
 }
 
-void opt15(std::unordered_map<uint32_t, uint32_t *> &map) {
+void opt15(AdjacencyMap &map, const IdTranslation *ids) {
     uint32_t v = UINT32_MAX;
     std::string vs;
     std::cout << "Input vertex to parse: ";
     while (v == UINT32_MAX) {
         std::cin >> vs;
-        v = s2i(vs);
+        v = internal_id(ids, s2i(vs));
     }
-    auto it = map.begin();
+    auto it = map.find(v);
     if (it == map.end()) return;
-    for (uint16_t i = 1; i <= map[v][0]; i++) std::cout << map[v][i] << " ";
+    for (uint16_t i = 1; i <= it->second[0]; i++)
+        std::cout << client_id(ids, it->second[i]) << " ";
     std::cout << "\n";
 }
 
-void opt16(std::unordered_map<uint32_t, uint32_t *> &map) {
+void opt16(AdjacencyMap &map, const IdTranslation *ids) {
     uint32_t v = UINT32_MAX;
     std::string vs;
     std::cout << "Input vertex to parse: ";
     while (v == UINT32_MAX) {
         std::cin >> vs;
-        v = s2i(vs);
+        v = internal_id(ids, s2i(vs));
     }
-    auto it = map.begin();
+    auto it = map.find(v);
     if (it == map.end()) return;
-    for (uint16_t i = 1; i <= map[v][0]; i++) std::cout << map[v][i] << " ";
+    for (uint16_t i = 1; i <= it->second[0]; i++)
+        std::cout << client_id(ids, it->second[i]) << " ";
     std::cout << "\n";
 }
 
-void save(std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs,
-          uint32_t Vertices, uint32_t Edges) {
+void opt17(Graph &graph, uint32_t vertex_buffer) {
+    char delta_filename[100];
+    std::cout << "Input delta file: ";
+    std::cin >> delta_filename;
+    if (!file_exists(delta_filename)) {
+        std::cout << "File " << delta_filename << " does not exist\n";
+        return;
+    }
+    apply_delta(graph, delta_filename, vertex_buffer);
+}
+
+void opt20(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Input the source vertex and the maximum number of hops "
+                 "(0 for no limit)\n";
+    uint32_t source = UINT32_MAX, max_hops = UINT32_MAX;
+    std::string s1, s2;
+    while (source == UINT32_MAX || max_hops == UINT32_MAX) {
+        std::cin >> s1 >> s2;
+        source = internal_id(ids, s2i(s1));
+        max_hops = s2i(s2);
+    }
+    if (max_hops == 0) max_hops = UINT32_MAX - 1;
+    std::cout << "Insert the vertices for which you want to get the distance\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    uint32_t reached;
+    uint32_t *result =
+        get_hop_distances(graph, source, arg_vertices, max_hops, reached);
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1]);
+        if (result[i] == UINT32_MAX)
+            std::cout << " is not reachable\n";
+        else
+            std::cout << " is " << result[i] << " hops away\n";
+    }
+    std::cout << reached << " vertices are reachable from "
+              << client_id(ids, source) << "\n";
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt26(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Insert the source vertices\n";
+    uint32_t *sources = read_ints(ids);
+    std::cout << "Insert the target vertices\n";
+    uint32_t *targets = read_ints(ids);
+
+    uint32_t *result = get_multi_hop_distances(graph, sources, targets);
+    uint32_t k = 1;
+    for (uint16_t i = 0; i < MAX_OPERATON_BUFFER && sources[i] != UINT32_MAX;
+         i++) {
+        std::cout << "From " << client_id(ids, sources[i]) << ":";
+        for (uint16_t j = 0;
+             j < MAX_OPERATON_BUFFER && targets[j] != UINT32_MAX; j++) {
+            std::cout << " " << client_id(ids, targets[j]) << "=";
+            if (result[k] == UINT32_MAX)
+                std::cout << "unreachable";
+            else
+                std::cout << result[k];
+            k++;
+        }
+        std::cout << "\n";
+    }
+
+    free(sources);
+    free(targets);
+    delete[] result;
+}
+
+void opt21(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    uint32_t source = UINT32_MAX;
+    std::string vs;
+    std::cout << "Input the source vertex: ";
+    while (source == UINT32_MAX) {
+        std::cin >> vs;
+        source = internal_id(ids, s2i(vs));
+    }
+    std::cout << "Insert the vertices for which you want to get the distance\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    uint64_t *result = get_distances(graph, source, arg_vertices);
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1]);
+        if (result[i] == UNREACHABLE)
+            std::cout << " is not reachable\n";
+        else
+            std::cout << " is at distance " << result[i] << "\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt22(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Input the vertices between which you want the shortest "
+                 "path\n";
+    Edge *arg_edges = read_edges(ids);
+
+    for (uint16_t i = 0; i < MAX_OPERATON_BUFFER; i++) {
+        uint32_t source = arg_edges[i].parent, target = arg_edges[i].child;
+        if (source == NULL_EDGE.parent && target == NULL_EDGE.child) break;
+        uint64_t distance;
+        std::vector<uint32_t> path =
+            get_shortest_path(graph, source, target, distance);
+        if (path.empty()) {
+            std::cout << "There is no path from " << client_id(ids, source)
+                      << " to " << client_id(ids, target) << "\n";
+            continue;
+        }
+        std::cout << "Path of length " << distance << ":";
+        for (uint32_t v : path) std::cout << " " << client_id(ids, v);
+        std::cout << "\n";
+    }
+
+    free(arg_edges);
+}
+
+void opt23(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Insert the vertices for which you want to get the strongly "
+                 "connected component\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    uint32_t count;
+    uint32_t *result = get_components(graph, arg_vertices, count);
+    std::cout << "The graph has " << count
+              << " strongly connected components\n";
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1]);
+        if (result[i] == UINT32_MAX)
+            std::cout << " is not in the graph\n";
+        else
+            std::cout << " is in component " << result[i] << "\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt24(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Use the edge weights? (1 for yes, 0 for no): ";
+    uint32_t weighted = UINT32_MAX;
+    std::string ws;
+    while (weighted > 1) {
+        std::cin >> ws;
+        weighted = s2i(ws);
+    }
+    std::cout << "Insert the vertices for which you want to get the rank\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    PageRankStats stats;
+    double *result = get_pagerank(graph, arg_vertices, weighted, stats);
+    for (size_t i = 0; i < stats.residuals.size(); i++) {
+        std::cout << "Iteration " << i + 1 << ": " << stats.iteration_ms[i]
+                  << " ms, change " << stats.residuals[i] << "\n";
+    }
+    std::cout << (stats.converged ? "Converged" : "Did not converge")
+              << " after " << stats.residuals.size() << " iterations\n";
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1])
+                  << " has rank " << result[i] << "\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt25(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Insert the vertices for which you want to get the "
+                 "topological level\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    uint32_t levels;
+    std::vector<uint32_t> cycle;
+    uint32_t *result =
+        get_topological_levels(graph, arg_vertices, levels, cycle);
+    if (!cycle.empty()) {
+        std::cout << "The graph is not acyclic, it contains the cycle:";
+        for (uint32_t v : cycle) std::cout << " " << client_id(ids, v);
+        std::cout << " " << client_id(ids, cycle[0]) << "\n";
+    }
+    std::cout << "The ordered vertices form " << levels << " levels\n";
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1]);
+        if (result[i] == UINT32_MAX)
+            std::cout << " is not ordered\n";
+        else
+            std::cout << " is on level " << result[i] << "\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt27(Graph &graph) {
+    uint32_t k = UINT32_MAX;
+    std::string ks;
+    std::cout << "Input the number of landmarks: ";
+    while (k == UINT32_MAX) {
+        std::cin >> ks;
+        k = s2i(ks);
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    graph.landmarks = build_landmarks(*get_csr(graph), k);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    std::cout << "Selected " << graph.landmarks->k << " landmarks in "
+              << duration.count() << " milliseconds:";
+    for (uint32_t v : graph.landmarks->landmarks)
+        std::cout << " " << client_id(graph.ids.get(), v);
+    std::cout << "\n";
+}
+
+void opt28(Graph &graph) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    auto start_time = std::chrono::high_resolution_clock::now();
+    graph.hierarchy = build_hierarchy(*csr);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    std::cout << "Built the hierarchy in " << duration.count()
+              << " milliseconds with " << graph.hierarchy->shortcuts
+              << " shortcuts, " << graph.hierarchy->core
+              << " vertices left uncontracted\n";
+
+    // latency of random queries, seeded so runs can be compared
+    std::vector<uint32_t> vertices;
+    for (uint32_t v = 0; v < csr->n; v++) {
+        if (csr->present[v]) vertices.push_back(v);
+    }
+    if (vertices.empty()) return;
+    std::mt19937 random(42);
+    std::vector<double> latency(1000);
+    for (double &micros : latency) {
+        uint32_t s = vertices[random() % vertices.size()];
+        uint32_t t = vertices[random() % vertices.size()];
+        start_time = std::chrono::high_resolution_clock::now();
+        ch_query(*graph.hierarchy, s, t);
+        end_time = std::chrono::high_resolution_clock::now();
+        micros = std::chrono::duration<double, std::micro>(end_time -
+                                                           start_time)
+                     .count();
+    }
+    std::sort(latency.begin(), latency.end());
+    std::cout << "Query latency over " << latency.size()
+              << " random pairs, in microseconds: p50 " << latency[499]
+              << ", p90 " << latency[899] << ", p99 " << latency[989]
+              << ", max " << latency[999] << "\n";
+}
+
+void opt29(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Use the edge weights? (1 for yes, 0 for no): ";
+    uint32_t weighted = UINT32_MAX;
+    std::string ws;
+    while (weighted > 1) {
+        std::cin >> ws;
+        weighted = s2i(ws);
+    }
+    std::cout << "Input the number of sources to sample (0 for exact): ";
+    uint32_t samples = UINT32_MAX;
+    std::string ss;
+    while (samples == UINT32_MAX) {
+        std::cin >> ss;
+        samples = s2i(ss);
+    }
+    std::cout << "Insert the vertices for which you want to get the "
+                 "centrality\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    BetweennessStats stats;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    double *result =
+        get_betweenness(graph, arg_vertices, weighted, samples, stats);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    std::cout << "Searched from " << stats.sources << " sources in "
+              << duration.count() << " milliseconds\n";
+    if (!stats.exact)
+        std::cout << "Estimates are within " << stats.error_bound
+                  << " of the exact values with probability "
+                  << BETWEENNESS_CONFIDENCE << "\n";
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1])
+                  << " has centrality " << result[i] << "\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt30(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Input the source and the sink of the flow: ";
+    uint32_t source = UINT32_MAX, sink = UINT32_MAX;
+    std::string vs;
+    while (source == UINT32_MAX) {
+        std::cin >> vs;
+        source = internal_id(ids, s2i(vs));
+    }
+    while (sink == UINT32_MAX) {
+        std::cin >> vs;
+        sink = internal_id(ids, s2i(vs));
+    }
+
+    uint64_t flow;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<Edge> cut = get_min_cut(graph, source, sink, flow);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    std::cout << "Maximum flow from " << client_id(ids, source) << " to "
+              << client_id(ids, sink) << " is " << flow << ", found in "
+              << duration.count() << " milliseconds\n";
+    std::cout << "Minimum cut of " << cut.size() << " edges:";
+    for (const Edge &e : cut) {
+        std::cout << " " << client_id(ids, e.parent) << "->"
+                  << client_id(ids, e.child);
+    }
+    std::cout << "\n";
+}
+
+void opt31(Graph &graph) {
+    WalkOptions options;
+    std::string filename, input;
+    std::cout << "Output file: ";
+    std::cin >> filename;
+    std::cout << "Input the walk length and the walks per vertex: ";
+    options.length = 0;
+    while (options.length == 0 || options.length == UINT32_MAX) {
+        std::cin >> input;
+        options.length = s2i(input);
+    }
+    options.walks_per_vertex = UINT32_MAX;
+    while (options.walks_per_vertex == UINT32_MAX) {
+        std::cin >> input;
+        options.walks_per_vertex = s2i(input);
+    }
+    std::cout << "Input the node2vec parameters p and q (1 1 for plain "
+                 "weighted walks): ";
+    options.p = options.q = 0;
+    while (options.p <= 0) {
+        std::cin >> input;
+        options.p = s2d(input);
+    }
+    while (options.q <= 0) {
+        std::cin >> input;
+        options.q = s2d(input);
+    }
+
+    WalkStats stats;
+    if (!get_walks(graph, options, filename, stats)) return;
+    std::cout << "Wrote " << stats.walks << " walks of " << stats.steps
+              << " steps in " << stats.seconds << " seconds, "
+              << (stats.seconds > 0 ? stats.steps / stats.seconds : 0)
+              << " steps/s\n";
+}
+
+void opt32(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Insert the vertices for which you want to get the "
+                 "triangles\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    std::vector<double> clustering;
+    uint64_t total;
+    double transitivity;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    uint64_t *result = get_triangles(graph, arg_vertices, clustering, total,
+                                     transitivity);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    std::cout << "The graph has " << total << " triangles, transitivity "
+              << transitivity << ", counted in " << duration.count()
+              << " milliseconds\n";
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1])
+                  << " is in " << result[i]
+                  << " triangles, clustering coefficient "
+                  << clustering[i - 1] << "\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt33(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Input the number of hops: ";
+    uint32_t hops = UINT32_MAX;
+    std::string hs;
+    while (hops == UINT32_MAX) {
+        std::cin >> hs;
+        hops = s2i(hs);
+    }
+    std::cout << "Insert the vertices for which you want to get the "
+                 "neighborhood size\n";
+    uint32_t *arg_vertices = read_ints(ids);
+
+    NeighborhoodFunction function;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    double *result =
+        get_neighborhood_sizes(graph, arg_vertices, hops, function);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    for (size_t t = 0; t < function.pairs.size(); t++) {
+        std::cout << "Pairs within " << t << " hops: " << function.pairs[t]
+                  << "\n";
+    }
+    std::cout << (function.converged ? "Converged" : "Stopped") << " after "
+              << function.pairs.size() - 1 << " iterations in "
+              << duration.count() << " milliseconds, effective diameter "
+              << function.effective_diameter << "\n";
+    for (uint16_t i = 1; i <= result[0]; i++) {
+        std::cout << "Vertex " << client_id(ids, arg_vertices[i - 1])
+                  << " reaches about " << result[i] << " vertices\n";
+    }
+
+    free(arg_vertices);
+    delete[] result;
+}
+
+void opt34(Graph &graph) {
+    const IdTranslation *ids = graph.ids.get();
+    std::cout << "Insert the pairs of vertices (format: vertex1 vertex2), "
+                 "type 'confirm' to finish:\n";
+    Edge *arg_edges = read_edges(ids);
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<ConnectivityIndex> index = get_connectivity(graph);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    std::cout << "Index ready in " << duration.count() << " milliseconds, "
+              << index->components << " weak components\n";
+    for (uint16_t i = 0; i < MAX_OPERATON_BUFFER; i++) {
+        Edge e = arg_edges[i];
+        if (e.parent == NULL_EDGE.parent && e.child == NULL_EDGE.child) break;
+        std::cout << "(" << client_id(ids, e.parent) << ", "
+                  << client_id(ids, e.child) << ") "
+                  << (connected(*index, e.parent, e.child) ? "connected"
+                                                           : "not connected")
+                  << "\n";
+    }
+
+    free(arg_edges);
+}
+
+// Best of three runs of a full BFS and of 20 PageRank iterations
+static void time_traversals(const CsrGraph &csr, uint32_t source,
+                            double &bfs_ms, double &pagerank_ms) {
+    bfs_ms = pagerank_ms = 0;
+    for (int run = 0; run < 3; run++) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        bfs_hops(csr, source);
+        auto middle_time = std::chrono::high_resolution_clock::now();
+        pagerank(csr, false, 0.85, 0, 20);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> bfs =
+            middle_time - start_time;
+        std::chrono::duration<double, std::milli> rank =
+            end_time - middle_time;
+        bfs_ms = run ? std::min(bfs_ms, bfs.count()) : bfs.count();
+        pagerank_ms = run ? std::min(pagerank_ms, rank.count()) : rank.count();
+    }
+}
+
+void opt35(Graph &graph) {
+    std::cout << "Order by 1. degree, 2. breadth-first search, 3. reverse "
+                 "Cuthill-McKee: ";
+    uint32_t method = UINT32_MAX;
+    std::string ms;
+    while (method < REORDER_DEGREE || method > REORDER_RCM) {
+        std::cin >> ms;
+        method = s2i(ms);
+    }
+
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    if (csr->n == 0) return;
+    uint32_t source = 0;
+    for (uint32_t v = 1; v < csr->n; v++) {
+        if (csr->out_offsets[v + 1] - csr->out_offsets[v] >
+            csr->out_offsets[source + 1] - csr->out_offsets[source])
+            source = v;
+    }
+    double bfs_before, pagerank_before, bfs_after, pagerank_after;
+    time_traversals(*csr, source, bfs_before, pagerank_before);
+    double gap_before = mean_log_gap(*csr);
+    csr.reset();
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<uint32_t> permutation = reorder_graph(graph, method);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    csr = get_csr(graph);
+    time_traversals(*csr, permutation[source], bfs_after, pagerank_after);
+
+    std::cout << "Reordered in " << duration.count() << " milliseconds\n";
+    std::cout << "Mean log2 gap between neighbors: " << gap_before << " -> "
+              << mean_log_gap(*csr) << "\n";
+    std::cout << "BFS from vertex " << client_id(graph.ids.get(),
+                                                 permutation[source])
+              << ": " << bfs_before << " ms -> " << bfs_after << " ms\n";
+    std::cout << "20 PageRank iterations: " << pagerank_before << " ms -> "
+              << pagerank_after << " ms\n";
+    std::cout << "Vertex IDs are unchanged\n";
+}
+
+void opt36() {
+    std::vector<WorkerStats> stats = worker_stats();
+    if (stats.empty()) {
+        std::cout << "No parallel work has run yet\n";
+        return;
+    }
+    double total = 0, most = 0;
+    for (size_t w = 0; w < stats.size(); w++) {
+        std::cout << "Worker " << w << ": " << stats[w].tasks << " tasks, "
+                  << stats[w].steals << " stolen, " << stats[w].busy_ms
+                  << " ms busy (" << stats[w].utilization * 100 << "%)\n";
+        total += stats[w].busy_ms;
+        most = std::max(most, stats[w].busy_ms);
+    }
+    if (total > 0) {
+        std::cout << "Busiest worker against the mean: "
+                  << most * stats.size() / total << "\n";
+    }
+    reset_worker_stats();
+}
+
+Graph *opt37(uint32_t vertex_buffer) {
+    GeneratorSpec spec;
+    std::cout << "Model: 1. uniform, 2. R-MAT, 3. power law: ";
+    spec.model = UINT32_MAX;
+    std::string ms;
+    while (spec.model < GENERATE_UNIFORM || spec.model > GENERATE_POWER_LAW) {
+        std::cin >> ms;
+        spec.model = s2i(ms);
+    }
+    std::cout << "Input the number of vertices and edges: ";
+    spec.vertices = UINT32_MAX;
+    uint32_t edges = UINT32_MAX;
+    std::string vs, es;
+    while (spec.vertices == UINT32_MAX || edges == UINT32_MAX) {
+        std::cin >> vs >> es;
+        spec.vertices = s2i(vs);
+        edges = s2i(es);
+    }
+    spec.edges = edges;
+    std::cout << "Input the seed: ";
+    uint32_t seed = UINT32_MAX;
+    std::string ss;
+    while (seed == UINT32_MAX) {
+        std::cin >> ss;
+        seed = s2i(ss);
+    }
+    spec.seed = seed;
+    std::cout << "Drop repeated edges? (1 for yes, 0 for no): ";
+    uint32_t dedup = UINT32_MAX;
+    std::string ds;
+    while (dedup > 1) {
+        std::cin >> ds;
+        dedup = s2i(ds);
+    }
+    spec.dedup = dedup;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+    Graph *graph = generate_graph(spec, vertex_buffer);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time);
+    if (graph == nullptr) return nullptr;
+    std::cout << "Generated " << graph->vertices << " vertices and "
+              << graph->edges << " edges in " << duration.count()
+              << " milliseconds\n";
+    return graph;
+}
+
+void opt38() {
+    std::cout << "1. Latency table, 2. Prometheus text, 3. JSON, 4. Reset, "
+                 "5. Hardware counters on/off: ";
+    uint32_t choice = UINT32_MAX;
+    std::string cs;
+    while (choice < 1 || choice > 5) {
+        std::cin >> cs;
+        choice = s2i(cs);
+    }
+    if (choice == 5) {
+        if (hw_counters_enabled()) {
+            set_hw_counters_enabled(false);
+            std::cout << "Hardware counters off\n";
+        } else if (set_hw_counters_enabled(true)) {
+            std::cout << "Hardware counters on:";
+            uint32_t available = hw_counters_available();
+            for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+                if (available & (1u << c))
+                    std::cout << " " << hw_counter_name(c);
+            }
+            std::cout << "\n";
+        } else {
+            std::cout << "No hardware counter can be opened; check "
+                         "/proc/sys/kernel/perf_event_paranoid\n";
+        }
+        return;
+    }
+    if (choice == 4) {
+        reset_metrics();
+        std::cout << "Metrics reset\n";
+        return;
+    }
+    if (choice == 1) {
+        for (const OperationMetrics &m : metrics_snapshot()) {
+            if (m.calls == 0) continue;
+            std::cout << m.name << ": " << m.calls << " calls, " << m.items
+                      << " items, mean " << m.total_ns / 1e3 / m.calls
+                      << " us, p50 " << latency_quantile(m, 0.5) / 1e3
+                      << " us, p99 " << latency_quantile(m, 0.99) / 1e3
+                      << " us, max " << m.max_ns / 1e3 << " us\n";
+            for (uint32_t c = 0; c < HW_COUNTER_COUNT; c++) {
+                if (m.counted[c] == 0) continue;
+                std::cout << "    " << hw_counter_name(c) << " per call: "
+                          << static_cast<double>(m.events[c]) / m.counted[c]
+                          << "\n";
+            }
+        }
+        return;
+    }
+
+    std::string filename;
+    std::cout << "Write to (- for the screen): ";
+    std::cin >> filename;
+    if (filename == "-") {
+        if (choice == 2)
+            write_metrics_prometheus(std::cout);
+        else
+            write_metrics_json(std::cout);
+        return;
+    }
+    std::ofstream output(filename);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open file " << filename << std::endl;
+        return;
+    }
+    if (choice == 2)
+        write_metrics_prometheus(output);
+    else
+        write_metrics_json(output);
+    std::cout << "Metrics written to " << filename << "\n";
+}
+
+void save(const Graph &graph) {
     std::string filename;
     std::cout << "Save As: ";
     std::cin >> filename;
-    write_data(costs, Vertices, Edges, filename);
+    write_data(*graph.costs, graph.vertices, graph.edges, filename,
+               graph.ids.get());
+    if (graph.landmarks)
+        save_landmarks(*graph.landmarks, graph, landmark_file(filename));
+    if (graph.hierarchy)
+        save_hierarchy(*graph.hierarchy, graph, hierarchy_file(filename));
 }
 
-int import(std::unordered_map<uint32_t, uint32_t *> &inbound,
-           std::unordered_map<uint32_t, uint32_t *> &outbound,
-           std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                              pair_hash> &costs,
-           uint32_t &Vertices, uint32_t &Edges, uint32_t vertex_buffer,
-           IdManager &manager, char *filename) {
+int import(GraphReloader &reloader, uint32_t vertex_buffer, char *filename) {
     char tmp_filename[100];
     std::cin >> tmp_filename;
-    if (file_exists(tmp_filename)) {
-        strcpy(filename, tmp_filename);
-        return 2;
+    if (!file_exists(tmp_filename)) {
+        std::cout << "File " << tmp_filename << " does not exist\n";
+        return 0;
+    }
+    if (!start_reload(reloader, tmp_filename, vertex_buffer)) {
+        std::cout << "Graph " << reloader.filename
+                  << " is still being loaded\n";
+        return 0;
     }
-    std::cout << "File " << tmp_filename << " does not exist\n";
+    strcpy(filename, tmp_filename);
+    std::cout << "Loading " << tmp_filename << " in the background\n";
     return 0;
 }
@@ -28,65 +28,74 @@
 #include <cstdint>
 #include <unordered_map>
 
+#include "GraphStore.h"
 #include "Structures.h"
 
+// Menu options take and print the vertex IDs clients use; after a reorder
+// they are translated to internal IDs when read and back when printed.
+
 /**
  * @brief Reads edges from input.
- * @return Pointer to a dynamically allocated array of edges.
+ * @param ids The graph's ID translation, may be null.
+ * @return Pointer to a dynamically allocated array of edges, with internal
+ * IDs.
  * @note The caller is responsible for freeing the allocated memory.
  */
-Edge *read_edges();
+Edge *read_edges(const IdTranslation *ids);
 
 /**
- * @brief Reads integers from input.
- * @return Pointer to a dynamically allocated array of integers.
+ * @brief Reads vertex IDs from input.
+ * @param ids The graph's ID translation, may be null.
+ * @return Pointer to a dynamically allocated array of internal IDs.
  * @note The caller is responsible for freeing the allocated memory.
  */
-uint32_t *read_ints();
+uint32_t *read_ints(const IdTranslation *ids);
 
 /**
  * @brief Checks if edges exist between vertices.
  * @param outbound The adjacency list representing outgoing edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt2(std::unordered_map<uint32_t, uint32_t *> &outbound);
+void opt2(AdjacencyMap &outbound, const IdTranslation *ids);
 
 /**
  * @brief Computes in-degree and out-degree of vertices.
  * @param outbound The adjacency list representing outgoing edges.
  * @param inbound The adjacency list representing incoming edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt3(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<uint32_t, uint32_t *> &inbound);
+void opt3(AdjacencyMap &outbound, AdjacencyMap &inbound,
+          const IdTranslation *ids);
 
 /**
  * @brief Retrieves outbound adjacency lists of vertices.
  * @param outbound The adjacency list representing outgoing edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt4(std::unordered_map<uint32_t, uint32_t *> &outbound);
+void opt4(AdjacencyMap &outbound, const IdTranslation *ids);
 
 /**
  * @brief Retrieves inbound adjacency lists of vertices.
  * @param inbound The adjacency list representing incoming edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt5(std::unordered_map<uint32_t, uint32_t *> &inbound);
+void opt5(AdjacencyMap &inbound, const IdTranslation *ids);
 
 /**
  * @brief Retrieves edge weights from the graph.
  * @param outbound The adjacency list representing outgoing edges.
  * @param costs The mapping of edges to their respective weights.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt6(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs);
+void opt6(AdjacencyMap &outbound, CostMap &costs, const IdTranslation *ids);
 
 /**
  * @brief Modifies the weights of existing edges.
  * @param outbound The adjacency list representing outgoing edges.
  * @param costs The mapping of edges to their respective weights.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt7(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs);
+void opt7(AdjacencyMap &outbound, CostMap &costs, const IdTranslation *ids);
 
 /**
  * @brief Adds new vertices to the graph.
@@ -95,10 +104,12 @@ void opt7(std::unordered_map<uint32_t, uint32_t *> &outbound,
  * @param manager The ID manager handling vertex allocations.
  * @param vertex_buffer Buffer size for adding vertices.
  * @param Vertices The total number of vertices in the graph.
+ * @param connectivity The connectivity index to update, may be null.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt8(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<uint32_t, uint32_t *> &inbound, IdManager &manager,
-          uint16_t vertex_buffer, uint32_t &Vertices);
+void opt8(AdjacencyMap &outbound, AdjacencyMap &inbound, IdManager &manager,
+          uint16_t vertex_buffer, uint32_t &Vertices,
+          ConnectivityIndex *connectivity, const IdTranslation *ids);
 
 /**
  * @brief Removes vertices from the graph.
@@ -107,12 +118,12 @@ void opt8(std::unordered_map<uint32_t, uint32_t *> &outbound,
  * @param costs The mapping of edges to their respective weights.
  * @param manager The ID manager handling vertex removals.
  * @param Vertices The total number of vertices in the graph.
+ * @param connectivity The connectivity index to update, may be null.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt9(std::unordered_map<uint32_t, uint32_t *> &outbound,
-          std::unordered_map<uint32_t, uint32_t *> &inbound,
-          std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs,
-          IdManager &manager, uint32_t &Vertices);
+void opt9(AdjacencyMap &outbound, AdjacencyMap &inbound, CostMap &costs,
+          IdManager &manager, uint32_t &Vertices,
+          ConnectivityIndex *connectivity, const IdTranslation *ids);
 
 /**
  * @brief Adds new edges to the graph.
@@ -121,12 +132,12 @@ void opt9(std::unordered_map<uint32_t, uint32_t *> &outbound,
  * @param outbound The adjacency list representing outgoing edges.
  * @param inbound The adjacency list representing incoming edges.
  * @param costs The mapping of edges to their respective weights.
+ * @param connectivity The connectivity index to update, may be null.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt10(uint16_t vertex_buffer, uint32_t &Edges,
-           std::unordered_map<uint32_t, uint32_t *> &outbound,
-           std::unordered_map<uint32_t, uint32_t *> &inbound,
-           std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                              pair_hash> &costs);
+void opt10(uint16_t vertex_buffer, uint32_t &Edges, AdjacencyMap &outbound,
+           AdjacencyMap &inbound, CostMap &costs,
+           ConnectivityIndex *connectivity, const IdTranslation *ids);
 
 /**
  * @brief Removes edges from the graph.
@@ -135,58 +146,182 @@ void opt10(uint16_t vertex_buffer, uint32_t &Edges,
  * @param outbound The adjacency list representing outgoing edges.
  * @param inbound The adjacency list representing incoming edges.
  * @param costs The mapping of edges to their respective weights.
+ * @param connectivity The connectivity index to update, may be null.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt11(uint16_t vertex_buffer, uint32_t &Edges,
-           std::unordered_map<uint32_t, uint32_t *> &outbound,
-           std::unordered_map<uint32_t, uint32_t *> &inbound,
-           std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                              pair_hash> &costs);
+void opt11(uint16_t vertex_buffer, uint32_t &Edges, AdjacencyMap &outbound,
+           AdjacencyMap &inbound, CostMap &costs,
+           ConnectivityIndex *connectivity, const IdTranslation *ids);
 
 /**
  * @brief Parses inbound adjacency lists of vertices.
  * @param map The adjacency list representing incoming or outgoing edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt14(std::unordered_map<uint32_t, uint32_t *> &map);
+void opt14(AdjacencyMap &map, const IdTranslation *ids);
 
 /**
  * @brief Parses inbound adjacency lists of vertices.
  * @param map The adjacency list representing incoming or outgoing edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt15(std::unordered_map<uint32_t, uint32_t *> &map);
+void opt15(AdjacencyMap &map, const IdTranslation *ids);
 
 /**
  * @brief Parses inbound adjacency lists of vertices.
  * @param map The adjacency list representing incoming or outgoing edges.
+ * @param ids The ID translation of the graph, may be null.
  */
-void opt16(std::unordered_map<uint32_t, uint32_t *> &map);
+void opt16(AdjacencyMap &map, const IdTranslation *ids);
 
 /**
- * @brief Saves a copy of the graph structure.
- * @param costs The mapping of edges to their respective weights.
- * @param Vertices The total number of vertices in the graph.
- * @param Edges The total number of edges in the graph.
+ * @brief Applies a delta file of edge changes to the graph.
+ * @param graph The graph to update.
+ * @param vertex_buffer Buffer size for managing vertices.
  */
-void save(std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t, pair_hash>
-              &costs,
-          uint32_t Vertices, uint32_t Edges);
+void opt17(Graph &graph, uint32_t vertex_buffer);
 
 /**
- * @brief Imports a graph from a file.
- * @param inbound The adjacency list representing incoming edges.
- * @param outbound The adjacency list representing outgoing edges.
- * @param costs The mapping of edges to their respective weights.
- * @param Vertices The total number of vertices in the graph.
- * @param Edges The total number of edges in the graph.
+ * @brief Retrieves how many hops away vertices are from a source vertex.
+ * @param graph The graph to search.
+ */
+void opt20(Graph &graph);
+
+/**
+ * @brief Retrieves weighted distances from a source vertex.
+ * @param graph The graph to search.
+ */
+void opt21(Graph &graph);
+
+/**
+ * @brief Retrieves a shortest weighted path between two vertices.
+ * @param graph The graph to search.
+ */
+void opt22(Graph &graph);
+
+/**
+ * @brief Retrieves the strongly connected components of vertices.
+ * @param graph The graph to search.
+ */
+void opt23(Graph &graph);
+
+/**
+ * @brief Retrieves the PageRank of vertices.
+ * @param graph The graph to rank.
+ */
+void opt24(Graph &graph);
+
+/**
+ * @brief Retrieves the topological level of vertices, or a cycle.
+ * @param graph The graph to order.
+ */
+void opt25(Graph &graph);
+
+/**
+ * @brief Retrieves the hop distances between many pairs of vertices.
+ * @param graph The graph to search.
+ */
+void opt26(Graph &graph);
+
+/**
+ * @brief Selects landmarks that speed up shortest path queries.
+ * @param graph The graph to preprocess.
+ */
+void opt27(Graph &graph);
+
+/**
+ * @brief Builds a contraction hierarchy for shortest path queries and
+ * reports its size and query latency.
+ * @param graph The graph to preprocess.
+ */
+void opt28(Graph &graph);
+
+/**
+ * @brief Retrieves the betweenness centrality of vertices, exact or
+ * estimated from sampled sources.
+ * @param graph The graph to analyze.
+ */
+void opt29(Graph &graph);
+
+/**
+ * @brief Computes the maximum flow between two vertices, with the weights
+ * as capacities, and the edges of a minimum cut.
+ * @param graph The graph to analyze.
+ */
+void opt30(Graph &graph);
+
+/**
+ * @brief Writes weighted or node2vec random walks from every vertex to a
+ * binary file.
+ * @param graph The graph to walk.
+ */
+void opt31(Graph &graph);
+
+/**
+ * @brief Counts the triangles through vertices and in the whole graph,
+ * with their clustering coefficients.
+ * @param graph The graph to analyze.
+ */
+void opt32(Graph &graph);
+
+/**
+ * @brief Estimates how many vertices others reach within a number of hops,
+ * and the effective diameter.
+ * @param graph The graph to analyze.
+ */
+void opt33(Graph &graph);
+
+/**
+ * @brief Tells whether pairs of vertices are weakly connected, keeping the
+ * connectivity index for later mutations to update.
+ * @param graph The graph to analyze.
+ */
+void opt34(Graph &graph);
+
+/**
+ * @brief Renumbers the vertices for memory locality and compares traversal
+ * times before and after.
+ * @param graph The graph to reorder.
+ */
+void opt35(Graph &graph);
+
+/**
+ * @brief Prints what every worker thread has done since the last call, and
+ * how evenly the work was spread.
+ */
+void opt36();
+
+/**
+ * @brief Builds a random graph in memory from the settings the user gives.
+ * @param vertex_buffer Spare cells of every adjacency list.
+ * @return Graph* The new graph, or nullptr if the settings are invalid.
+ */
+Graph *opt37(uint32_t vertex_buffer);
+
+/**
+ * @brief Shows the call counts, latencies and hardware events of the graph
+ * operations, dumps them for monitoring tools, resets them, or turns the
+ * hardware counters on or off.
+ */
+void opt38();
+
+/**
+ * @brief Saves a copy of the graph structure, with its landmark table and
+ * contraction hierarchy.
+ * @param graph The graph to save.
+ */
+void save(const Graph &graph);
+
+/**
+ * @brief Starts importing a graph from a file in the background.
+ *
+ * The current graph keeps serving requests while the new one is loaded, the
+ * two are swapped once loading is done.
+ * @param reloader The background reload state.
  * @param vertex_buffer Buffer size for managing vertices.
- * @param manager The ID manager for handling vertex allocations.
- * @param filename The name of the file to import from.
- * @return int Returns 0 on success, or an error code on failure.
- */
-int import(std::unordered_map<uint32_t, uint32_t *> &inbound,
-           std::unordered_map<uint32_t, uint32_t *> &outbound,
-           std::unordered_map<std::pair<uint32_t, uint32_t>, uint32_t,
-                              pair_hash> &costs,
-           uint32_t &Vertices, uint32_t &Edges, uint32_t vertex_buffer,
-           IdManager &manager, char *filename);
+ * @param filename Set to the name of the imported file.
+ * @return int Returns 0 after the import was started or rejected.
+ */
+int import(GraphReloader &reloader, uint32_t vertex_buffer, char *filename);
 
 #endif  // UIREAD_H_
@@ -0,0 +1,244 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Csr.h"
+#include "Parallel.h"
+#include "Reorder.h"
+#include "Structures.h"
+#include "Walks.h"
+
+static const char WALK_MAGIC[4] = {'W', 'L', 'K', '1'};
+// Start vertices per chunk, which is also the unit a generator is seeded for
+#define WALK_GRAIN 256
+// Bytes a thread buffers before appending them to the file
+#define WALK_BUFFER (1 << 20)
+
+// splitmix64: one multiply-xorshift chain per number, cheap enough to be
+// called twice per step
+struct WalkRandom {
+    uint64_t state;
+
+    explicit WalkRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // uniform in [0, bound)
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    // uniform in [0, 1)
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+std::shared_ptr<const AliasTable> build_alias_table(const CsrGraph &csr) {
+    std::shared_ptr<AliasTable> table = std::make_shared<AliasTable>();
+    table->probability.resize(csr.m);
+    table->alias.resize(csr.m);
+    parallel_for(
+        0, csr.n,
+        [&](size_t from, size_t to) {
+            std::vector<double> scaled;
+            std::vector<uint32_t> small, large;
+            for (size_t v = from; v < to; v++) {
+                uint64_t begin = csr.out_offsets[v];
+                uint32_t degree =
+                    static_cast<uint32_t>(csr.out_offsets[v + 1] - begin);
+                if (degree == 0) continue;
+                double total = 0;
+                for (uint32_t k = 0; k < degree; k++)
+                    total += csr.out_weights[begin + k];
+
+                // Vose's method: pair every slot below the average with
+                // one above it
+                scaled.resize(degree);
+                small.clear();
+                large.clear();
+                for (uint32_t k = 0; k < degree; k++) {
+                    scaled[k] =
+                        total > 0 ? csr.out_weights[begin + k] * degree / total
+                                  : 1;
+                    (scaled[k] < 1 ? small : large).push_back(k);
+                }
+                while (!small.empty() && !large.empty()) {
+                    uint32_t s = small.back(), l = large.back();
+                    small.pop_back();
+                    table->probability[begin + s] =
+                        static_cast<float>(scaled[s]);
+                    table->alias[begin + s] = l;
+                    scaled[l] -= 1 - scaled[s];
+                    if (scaled[l] < 1) {
+                        large.pop_back();
+                        small.push_back(l);
+                    }
+                }
+                // what is left is 1 up to rounding
+                for (uint32_t k : small) {
+                    table->probability[begin + k] = 1;
+                    table->alias[begin + k] = k;
+                }
+                for (uint32_t k : large) {
+                    table->probability[begin + k] = 1;
+                    table->alias[begin + k] = k;
+                }
+            }
+        },
+        4096);
+    return table;
+}
+
+static inline uint32_t sample_child(const CsrGraph &csr,
+                                    const AliasTable &table, uint32_t v,
+                                    WalkRandom &random) {
+    uint64_t begin = csr.out_offsets[v];
+    uint32_t degree = static_cast<uint32_t>(csr.out_offsets[v + 1] - begin);
+    uint32_t k = random.below(degree);
+    if (random.unit() >= table.probability[begin + k])
+        k = table.alias[begin + k];
+    return csr.out_targets[begin + k];
+}
+
+static inline bool is_child(const CsrGraph &csr, uint32_t parent,
+                            uint32_t child) {
+    const uint32_t *first = csr.out_targets.data() + csr.out_offsets[parent];
+    const uint32_t *last =
+        csr.out_targets.data() + csr.out_offsets[parent + 1];
+    return std::binary_search(first, last, child);
+}
+
+int write_walks(const CsrGraph &csr, const AliasTable &table,
+                const WalkOptions &options, const std::string &filename,
+                WalkStats *stats, const IdTranslation *ids) {
+    if (!(options.p > 0) || !(options.q > 0)) {
+        std::cerr << "The walk parameters p and q must be positive\n";
+        return 0;
+    }
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open file " << filename << std::endl;
+        return 0;
+    }
+    uint64_t walks = 0;
+    output.write(WALK_MAGIC, sizeof(WALK_MAGIC));
+    output.write(reinterpret_cast<const char *>(&options.length),
+                 sizeof(options.length));
+    output.write(reinterpret_cast<const char *>(&walks), sizeof(walks));
+
+    std::vector<uint32_t> starts;
+    for (uint32_t v = 0; v < csr.n; v++) {
+        if (csr.present[v]) starts.push_back(v);
+    }
+    bool biased = options.p != 1 || options.q != 1;
+    double return_bias = 1 / options.p, out_bias = 1 / options.q;
+    double max_bias = std::max(1.0, std::max(return_bias, out_bias));
+
+    std::mutex write;
+    uint64_t steps = 0;
+    uint64_t total = starts.size() * uint64_t(options.walks_per_vertex);
+    parallel_for(
+        0, total,
+        [&](size_t from, size_t to) {
+            WalkRandom random(options.seed ^
+                              (from * 0xd1b54a32d192ed03ULL + 1));
+            std::vector<uint32_t> buffer;
+            uint64_t local_steps = 0;
+            auto flush = [&]() {
+                std::lock_guard<std::mutex> lock(write);
+                output.write(reinterpret_cast<const char *>(buffer.data()),
+                             buffer.size() * sizeof(uint32_t));
+                buffer.clear();
+            };
+            for (size_t i = from; i < to; i++) {
+                // walk i starts from vertex i / walks_per_vertex
+                uint32_t v = starts[i / options.walks_per_vertex];
+                size_t header = buffer.size();
+                buffer.push_back(0);
+                buffer.push_back(client_id(ids, v));
+                uint32_t previous = UINT32_MAX;
+                for (uint32_t step = 1; step < options.length; step++) {
+                    if (csr.out_offsets[v] == csr.out_offsets[v + 1]) break;
+                    uint32_t x = sample_child(csr, table, v, random);
+                    while (biased && previous != UINT32_MAX) {
+                        double bias = x == previous
+                                          ? return_bias
+                                          : is_child(csr, previous, x)
+                                                ? 1
+                                                : out_bias;
+                        if (random.unit() * max_bias < bias) break;
+                        x = sample_child(csr, table, v, random);
+                    }
+                    previous = v;
+                    v = x;
+                    buffer.push_back(client_id(ids, v));
+                    local_steps++;
+                }
+                buffer[header] =
+                    static_cast<uint32_t>(buffer.size() - header - 1);
+                if (buffer.size() * sizeof(uint32_t) >= WALK_BUFFER) flush();
+            }
+            flush();
+            std::lock_guard<std::mutex> lock(write);
+            steps += local_steps;
+        },
+        WALK_GRAIN);
+
+    walks = total;
+    output.seekp(sizeof(WALK_MAGIC) + sizeof(options.length));
+    output.write(reinterpret_cast<const char *>(&walks), sizeof(walks));
+    output.close();
+
+    if (stats) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        stats->walks = walks;
+        stats->steps = steps;
+        stats->seconds =
+            std::chrono::duration<double>(end_time - start_time).count();
+    }
+    return output.good() ? 1 : 0;
+}
+
+int get_walks(Graph &graph, const WalkOptions &options,
+              const std::string &filename, WalkStats &stats) {
+    std::shared_ptr<const CsrGraph> csr = get_csr(graph);
+    std::shared_ptr<const AliasTable> table = build_alias_table(*csr);
+    return write_walks(*csr, *table, options, filename, &stats,
+                       graph.ids.get());
+}
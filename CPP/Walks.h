@@ -0,0 +1,127 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef WALKS_H_
+#define WALKS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Csr.h"
+#include "Structures.h"
+
+/**
+ * @brief Alias tables for sampling outbound edges by weight in O(1).
+ *
+ * Entries line up with the outbound CSR arrays: to sample from vertex v,
+ * pick a slot k of its list uniformly, then keep k with probability
+ * `probability[out_offsets[v] + k]` or take `alias[out_offsets[v] + k]`,
+ * also an index within v's list. Vertices whose edges all weigh 0 sample
+ * uniformly.
+ */
+struct AliasTable {
+    std::vector<float> probability;  ///< Chance of keeping the slot.
+    std::vector<uint32_t> alias;     ///< Slot taken otherwise.
+};
+
+/**
+ * @brief Settings of a batch of random walks.
+ *
+ * With `p` and `q` both 1 the walks are first-order: every step follows an
+ * outbound edge with probability proportional to its weight. Otherwise
+ * they are node2vec walks, where the weight of a step from v to x, having
+ * arrived at v from t, is further multiplied by 1/p if x is t, by 1 if x is
+ * a child of t, and by 1/q otherwise.
+ */
+struct WalkOptions {
+    uint32_t length = 80;            ///< Vertices per walk, start included.
+    uint32_t walks_per_vertex = 10;  ///< Walks started from every vertex.
+    double p = 1;                    ///< Return parameter.
+    double q = 1;                    ///< In-out parameter.
+    uint64_t seed = 1;               ///< Seed of the random generators.
+};
+
+/**
+ * @brief Throughput of a batch of random walks.
+ */
+struct WalkStats {
+    uint64_t walks = 0;   ///< Walks written.
+    uint64_t steps = 0;   ///< Edges followed over all walks.
+    double seconds = 0;   ///< Time spent walking and writing.
+};
+
+/**
+ * @brief Builds the alias tables of all vertices in parallel.
+ * @param csr The graph.
+ * @return std::shared_ptr<const AliasTable> The tables.
+ */
+std::shared_ptr<const AliasTable> build_alias_table(const CsrGraph &csr);
+
+/**
+ * @brief Runs random walks from every vertex and streams them to a file.
+ *
+ * Walks run in parallel, each chunk of start vertices with its own
+ * generator seeded from `options.seed` and the chunk, so the set of walks
+ * does not depend on the number of threads; their order in the file does.
+ * node2vec steps draw a child from the alias table and accept it with
+ * probability (its bias) / (largest bias), which needs no per-edge state
+ * for the second order. A walk stops early at a vertex without children.
+ *
+ * The file starts with the characters "WLK1", the walk length and the
+ * number of walks as a uint32_t and a uint64_t; every walk follows as its
+ * number of vertices (uint32_t) and the vertex IDs (uint32_t each). All
+ * values are in the machine's byte order.
+ *
+ * @param csr      The graph.
+ * @param table    Its alias tables.
+ * @param options  Settings of the walks.
+ * @param filename Name of the file to write.
+ * @param stats    If not null, filled with the throughput.
+ * @param ids      If not null, vertices are written with the client IDs it
+ * gives them.
+ * @return int 1 on success, 0 if the file could not be written.
+ */
+int write_walks(const CsrGraph &csr, const AliasTable &table,
+                const WalkOptions &options, const std::string &filename,
+                WalkStats *stats = nullptr,
+                const IdTranslation *ids = nullptr);
+
+/**
+ * @brief Runs random walks over a graph and streams them to a file.
+ *
+ * Vertices are written with the IDs clients use.
+ *
+ * @param graph    The graph, with the weights as step probabilities.
+ * @param options  Settings of the walks.
+ * @param filename Name of the file to write.
+ * @param stats    Filled with the throughput.
+ * @return int 1 on success, 0 if the file could not be written.
+ */
+int get_walks(Graph &graph, const WalkOptions &options,
+              const std::string &filename, WalkStats &stats);
+
+#endif  // WALKS_H_
@@ -0,0 +1,366 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Measures the batch operations of Data.h on a generated graph and reports
+// their throughput and latency percentiles, as a table and as a JSON file
+// that runs of different builds can be compared with.
+// Usage: bench_ops [vertices] [edges] [skew] [calls] [seed] [json file]
+// Endpoints of edges and queried vertices are drawn from a power law with
+// exponent `skew` over a shuffled vertex order, 0 for uniform; `calls` is
+// the number of batches timed per operation.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Data.h"
+#include "GraphStore.h"
+#include "Structures.h"
+
+// check_edges stops one entry short of the buffer, so batches leave room
+// for the terminator
+#define BATCH (MAX_OPERATON_BUFFER - 1)
+#define FILE_RUNS 3
+// spare cells per adjacency list, the default of the interactive program
+#define VERTEX_BUFFER 10
+#define GRAPH_FILE "bench_ops_graph.txt"
+#define COPY_FILE "bench_ops_copy.txt"
+
+struct Series {
+    std::string operation;
+    uint64_t items = 0;               // entries passed to the calls
+    std::vector<double> latency_us;  // one per call
+
+    explicit Series(const char *name) : operation(name) {}
+};
+
+// Picks vertices with probability falling as a power of their rank
+struct VertexPicker {
+    std::vector<uint32_t> order;
+    std::discrete_distribution<uint32_t> rank;
+    std::uniform_int_distribution<uint32_t> uniform;
+    bool skewed;
+};
+
+static VertexPicker make_picker(uint32_t n, double skew, std::mt19937_64 &rng) {
+    VertexPicker picker;
+    picker.order.resize(n);
+    std::iota(picker.order.begin(), picker.order.end(), 0);
+    std::shuffle(picker.order.begin(), picker.order.end(), rng);
+    picker.skewed = skew > 0;
+    if (picker.skewed) {
+        std::vector<double> weights(n);
+        for (uint32_t r = 0; r < n; r++) weights[r] = std::pow(r + 1.0, -skew);
+        picker.rank = std::discrete_distribution<uint32_t>(weights.begin(),
+                                                           weights.end());
+    }
+    picker.uniform = std::uniform_int_distribution<uint32_t>(0, n - 1);
+    return picker;
+}
+
+static uint32_t pick(VertexPicker &picker, std::mt19937_64 &rng) {
+    return picker.order[picker.skewed ? picker.rank(rng)
+                                      : picker.uniform(rng)];
+}
+
+static double since_us(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(p / 100 * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+// Writes a graph file with distinct edges and no self-loops
+static uint64_t generate(const char *filename, uint32_t n, uint64_t m,
+                         VertexPicker &picker, std::mt19937_64 &rng,
+                         std::vector<Edge> &edges) {
+    std::unordered_set<uint64_t> seen;
+    std::uniform_int_distribution<uint32_t> weight(1, 100);
+    uint64_t attempts = 20 * m + 1000;
+    while (edges.size() < m && attempts--) {
+        uint32_t parent = pick(picker, rng), child = pick(picker, rng);
+        if (parent == child ||
+            !seen.insert(static_cast<uint64_t>(parent) << 32 | child).second)
+            continue;
+        edges.push_back({parent, child});
+    }
+
+    std::ofstream file(filename);
+    file << n << " " << edges.size() << "\n";
+    for (const Edge &e : edges)
+        file << e.parent << " " << e.child << " " << weight(rng) << "\n";
+    return edges.size();
+}
+
+static void print_series(const Series &s) {
+    std::vector<double> sorted = s.latency_us;
+    std::sort(sorted.begin(), sorted.end());
+    double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+    std::cout << s.operation << "\t" << sorted.size() << "\t"
+              << (total > 0 ? s.items / total * 1e6 : 0) << "\t"
+              << percentile(sorted, 50) << "\t" << percentile(sorted, 90)
+              << "\t" << percentile(sorted, 99) << "\t"
+              << (sorted.empty() ? 0 : sorted.back()) << "\n";
+}
+
+static void write_json(const std::string &filename, uint32_t n, uint64_t m,
+                       double skew, uint32_t calls, uint64_t seed,
+                       const std::vector<Series> &results) {
+    std::ofstream out(filename);
+    out << "{\n  \"benchmark\": \"bench_ops\",\n";
+#ifdef __VERSION__
+    out << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+#ifdef __OPTIMIZE__
+    out << "  \"optimized\": true,\n";
+#else
+    out << "  \"optimized\": false,\n";
+#endif
+    out << "  \"config\": {\"vertices\": " << n << ", \"edges\": " << m
+        << ", \"skew\": " << skew << ", \"calls\": " << calls
+        << ", \"batch\": " << BATCH << ", \"seed\": " << seed << "},\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Series &s = results[i];
+        std::vector<double> sorted = s.latency_us;
+        std::sort(sorted.begin(), sorted.end());
+        double total = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+        out << "    {\"operation\": \"" << s.operation
+            << "\", \"calls\": " << sorted.size()
+            << ", \"items\": " << s.items << ", \"items_per_s\": "
+            << (total > 0 ? s.items / total * 1e6 : 0)
+            << ", \"latency_us\": {\"mean\": "
+            << (sorted.empty() ? 0 : total / sorted.size())
+            << ", \"p50\": " << percentile(sorted, 50)
+            << ", \"p90\": " << percentile(sorted, 90)
+            << ", \"p99\": " << percentile(sorted, 99)
+            << ", \"max\": " << (sorted.empty() ? 0 : sorted.back())
+            << "}}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main(int argc, char **argv) {
+    uint32_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    uint64_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10ull * n;
+    double skew = argc > 3 ? std::strtod(argv[3], nullptr) : 0;
+    uint32_t calls = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1000;
+    uint64_t seed = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1;
+    std::string json = argc > 6 ? argv[6] : "bench_ops.json";
+    if (n < 2 || calls == 0) {
+        std::cerr << "Need at least 2 vertices and 1 call\n";
+        return 1;
+    }
+
+    std::mt19937_64 rng(seed);
+    VertexPicker picker = make_picker(n, skew, rng);
+    std::vector<Edge> edges;
+    m = generate(GRAPH_FILE, n, m, picker, rng, edges);
+    std::cout << "Generated " << n << " vertices and " << m
+              << " edges, skew " << skew << "\n";
+    if (m == 0) {
+        std::cerr << "The generated graph has no edges\n";
+        std::remove(GRAPH_FILE);
+        return 1;
+    }
+
+    // the operations report their own progress on std::cout, which would
+    // be timed as well; a failed stream skips the formatting
+    std::vector<Series> results;
+    std::cout.setstate(std::ios::badbit);
+
+    Series read{"read_data"}, write{"write_data"};
+    Graph *graph = nullptr;
+    for (int run = 0; run < FILE_RUNS; run++) {
+        free_graph(graph);
+        graph = new_graph();
+        auto start = std::chrono::steady_clock::now();
+        read_data(*graph->inbound, *graph->outbound, *graph->costs,
+                  graph->vertices, graph->edges, GRAPH_FILE, VERTEX_BUFFER,
+                  *graph->manager);
+        read.latency_us.push_back(since_us(start));
+        read.items += m;
+    }
+    for (int run = 0; run < FILE_RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        write_data(*graph->costs, graph->vertices, graph->edges, COPY_FILE);
+        write.latency_us.push_back(since_us(start));
+        write.items += m;
+    }
+    results.push_back(read);
+    results.push_back(write);
+
+    // internal IDs of the generated vertices
+    std::vector<uint32_t> id(n);
+    for (uint32_t v = 0; v < n; v++) {
+        auto it = graph->manager->map.find(v);
+        id[v] = it == graph->manager->map.end() ? UINT32_MAX : it->second;
+    }
+    auto random_vertex = [&]() {
+        uint32_t v;
+        do v = id[pick(picker, rng)];
+        while (v == UINT32_MAX);
+        return v;
+    };
+
+    // half of the queried edges exist, half are random pairs
+    std::vector<Edge> queries((BATCH + 1) * calls, NULL_EDGE);
+    std::vector<uint32_t> vertices((BATCH + 1) * calls, UINT32_MAX);
+    std::uniform_int_distribution<uint64_t> any_edge(0, m ? m - 1 : 0);
+    for (uint32_t k = 0; k < calls; k++) {
+        for (uint32_t i = 0; i < BATCH; i++) {
+            Edge &q = queries[k * (BATCH + 1) + i];
+            if (m && i % 2 == 0) {
+                const Edge &e = edges[any_edge(rng)];
+                q = {id[e.parent], id[e.child]};
+            } else {
+                q = {random_vertex(), random_vertex()};
+            }
+            vertices[k * (BATCH + 1) + i] = random_vertex();
+        }
+    }
+
+    Series check{"check_edges"}, degree{"get_degree"},
+        connections{"get_vertices_connections"},
+        weights{"get_weights_of_edges"};
+    for (uint32_t k = 0; k < calls; k++) {
+        Edge *batch = &queries[k * (BATCH + 1)];
+        uint32_t *list = &vertices[k * (BATCH + 1)];
+
+        auto start = std::chrono::steady_clock::now();
+        uint8_t *found = check_edges(batch, *graph->outbound);
+        check.latency_us.push_back(since_us(start));
+        check.items += BATCH;
+        delete[] found;
+
+        start = std::chrono::steady_clock::now();
+        uint32_t *degrees = get_degree(*graph->outbound, list);
+        degree.latency_us.push_back(since_us(start));
+        degree.items += BATCH;
+        delete[] degrees;
+
+        start = std::chrono::steady_clock::now();
+        vertex_map *lists = get_vertices_connections(*graph->outbound, list);
+        connections.latency_us.push_back(since_us(start));
+        connections.items += BATCH;
+        free(lists);
+
+        start = std::chrono::steady_clock::now();
+        uint16_t *found_weights =
+            get_weights_of_edges(batch, *graph->outbound, *graph->costs);
+        weights.latency_us.push_back(since_us(start));
+        weights.items += BATCH;
+        delete[] found_weights;
+    }
+    results.push_back(check);
+    results.push_back(degree);
+    results.push_back(connections);
+    results.push_back(weights);
+
+    // the added edges are removed again, so every call sees the same graph
+    Series add{"add_edges"}, remove{"remove_edges"};
+    std::vector<Edge> fresh(BATCH + 1, NULL_EDGE);
+    std::vector<uint32_t> new_weights(BATCH, 1);
+    for (uint32_t k = 0; k < calls; k++) {
+        for (uint32_t i = 0; i < BATCH; i++)
+            fresh[i] = {random_vertex(), random_vertex()};
+
+        auto start = std::chrono::steady_clock::now();
+        uint32_t *added = add_edges(fresh.data(), new_weights.data(),
+                                    VERTEX_BUFFER, *graph->outbound,
+                                    *graph->inbound, *graph->costs);
+        add.latency_us.push_back(since_us(start));
+        add.items += BATCH;
+
+        // only the edges that were new, so the original ones stay
+        std::vector<Edge> undo(BATCH + 1, NULL_EDGE);
+        uint32_t added_count = added[0];
+        for (uint32_t i = 1; i <= added_count; i++)
+            undo[i - 1] = fresh[added[i]];
+        delete[] added;
+        start = std::chrono::steady_clock::now();
+        uint32_t *removed =
+            remove_edges(undo.data(), VERTEX_BUFFER, *graph->outbound,
+                         *graph->inbound, *graph->costs);
+        remove.latency_us.push_back(since_us(start));
+        remove.items += added_count;
+        delete[] removed;
+    }
+    results.push_back(add);
+    results.push_back(remove);
+
+    // distinct vertices in uniform order, at most half of the graph; a
+    // skewed draw would take long to find that many distinct ones
+    Series remove_v{"remove_vertices"};
+    std::vector<uint32_t> order;
+    for (uint32_t v : id) {
+        if (v != UINT32_MAX) order.push_back(v);
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    order.resize(std::min<uint64_t>(static_cast<uint64_t>(calls) * BATCH,
+                                    order.size() / 2));
+    std::vector<uint32_t> victims(BATCH + 1);
+    for (size_t from = 0; from < order.size(); from += BATCH) {
+        size_t size = std::min<size_t>(BATCH, order.size() - from);
+        std::copy(order.begin() + from, order.begin() + from + size,
+                  victims.begin());
+        victims[size] = UINT32_MAX;
+
+        auto start = std::chrono::steady_clock::now();
+        uint32_t *removed =
+            remove_vertices(victims.data(), *graph->manager, *graph->outbound,
+                            *graph->inbound, *graph->costs);
+        remove_v.latency_us.push_back(since_us(start));
+        remove_v.items += size;
+        free(removed);
+    }
+    results.push_back(remove_v);
+
+    free_graph(graph);
+    std::remove(GRAPH_FILE);
+    std::remove(COPY_FILE);
+    std::cout.clear();
+
+    std::cout << "operation\tcalls\titems/s\tp50 us\tp90 us\tp99 us\tmax us\n";
+    for (const Series &s : results) print_series(s);
+    write_json(json, n, m, skew, calls, seed, results);
+    std::cout << "Results written to " << json << "\n";
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Measures how the strongly connected components search scales with the
+// number of threads on a generated graph.
+// Usage: bench_scc [vertices] [edges] [max threads] [seed]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Csr.h"
+#include "Parallel.h"
+#include "Scc.h"
+#include "Structures.h"
+
+double elapsed_ms(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char **argv) {
+    uint32_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    uint64_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4ull * n;
+    uint32_t max_threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10)
+                                    : worker_count();
+    if (max_threads == 0) max_threads = 1;
+    uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+
+    std::cout << "Generating " << n << " vertices and " << m << " edges\n";
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<uint32_t> pick(0, n - 1);
+    std::vector<Edge> edges(m);
+    for (Edge &e : edges) e = {pick(rng), pick(rng)};
+    std::shared_ptr<const CsrGraph> csr = build_csr(n, edges, {});
+
+    uint32_t expected_count;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<uint32_t> expected = scc_tarjan(*csr, expected_count);
+    double tarjan_ms = elapsed_ms(start);
+    std::cout << "Tarjan: " << tarjan_ms << " ms, " << expected_count
+              << " components\n";
+
+    std::cout << "threads\tms\tspeedup vs Tarjan\n";
+    // powers of two, and always max_threads itself
+    std::vector<uint32_t> thread_counts;
+    for (uint32_t threads = 1; threads < max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(max_threads);
+    for (uint32_t threads : thread_counts) {
+        set_worker_count(threads);
+        uint32_t count;
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<uint32_t> comp = scc_parallel(*csr, count);
+        double ms = elapsed_ms(start);
+        if (comp != expected) {
+            std::cerr << "Parallel result differs from Tarjan\n";
+            return 1;
+        }
+        std::cout << threads << "\t" << ms << "\t" << tarjan_ms / ms << "\n";
+    }
+    return 0;
+}
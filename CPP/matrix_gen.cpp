@@ -1,74 +1,117 @@
+// Copyright (C) 2025 Temrer
+// All rights reserved.
+//
+// This file is part of the project [Project Name].
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// - Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+// Writes a random graph file that the graph program can load.
+// Usage: matrix_gen [file vertices edges [options]]
+//   --model uniform|rmat|powerlaw  how edges are drawn (uniform)
+//   --seed N                       seed of the generator (1)
+//   --rmat a,b,c                   R-MAT quadrant probabilities
+//   --exponent g                   exponent of the power-law degrees (2.1)
+//   --max-weight w                 weights are drawn from 1 .. w (100)
+//   --dedup                        drop repeated edges
+//   --binary                       write the binary format
+//   --threads t                    worker threads (all hardware threads)
+// Without arguments the file name and sizes are asked for.
+
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
-#include <ctime>
-#include <fstream>
 #include <iostream>
 #include <string>
-#include <unordered_set>
 
-void generate_random_graph_to_file(uint32_t n, uint32_t m,
-                                   const std::string& filename) {
-    // Initialize random seed
-    std::srand(static_cast<unsigned int>(std::time(0)));
+#include "Generator.h"
+#include "Parallel.h"
 
-    // Open file for writing
-    std::ofstream file(filename);
+static int usage() {
+    std::cerr << "Usage: matrix_gen [file vertices edges [--model "
+                 "uniform|rmat|powerlaw] [--seed N] [--rmat a,b,c] "
+                 "[--exponent g] [--max-weight w] [--dedup] [--binary] "
+                 "[--threads t]]\n";
+    return 1;
+}
 
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file for writing!" << std::endl;
-        return;
+int main(int argc, char **argv) {
+    GeneratorSpec spec;
+    std::string filename;
+    bool binary = false;
+
+    if (argc == 1) {
+        std::cout << "Input name of file: ";
+        std::cin >> filename;
+        std::cout << "Input number of vertices and edges\n";
+        std::cin >> spec.vertices >> spec.edges;
+    } else if (argc < 4) {
+        return usage();
+    } else {
+        filename = argv[1];
+        spec.vertices = std::strtoul(argv[2], nullptr, 10);
+        spec.edges = std::strtoull(argv[3], nullptr, 10);
     }
 
-    // Write the number of vertices (n) and edges (m) to the file
-    file << n << " " << m << std::endl;
-
-    // Set to track which vertices have been added as either parent or child
-    std::unordered_set<uint32_t> vertices_in_graph;
-
-    // Generate and write m random edges to the file
-    for (uint32_t i = 0; i < m; ++i) {
-        uint32_t origin = std::rand() % n;  // Random origin vertex
-        uint32_t target = std::rand() % n;  // Random target vertex
-
-        // Ensure origin and target are not the same (no self-loops)
-        while (origin == target) {
-            target = std::rand() % n;
+    for (int i = 4; i < argc; i++) {
+        std::string option = argv[i];
+        bool has_value = i + 1 < argc;
+        if (option == "--dedup") {
+            spec.dedup = true;
+        } else if (option == "--binary") {
+            binary = true;
+        } else if (option == "--model" && has_value) {
+            std::string model = argv[++i];
+            if (model == "uniform")
+                spec.model = GENERATE_UNIFORM;
+            else if (model == "rmat")
+                spec.model = GENERATE_RMAT;
+            else if (model == "powerlaw")
+                spec.model = GENERATE_POWER_LAW;
+            else
+                return usage();
+        } else if (option == "--seed" && has_value) {
+            spec.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (option == "--rmat" && has_value) {
+            char *end;
+            spec.a = std::strtod(argv[++i], &end);
+            spec.b = *end == ',' ? std::strtod(end + 1, &end) : -1;
+            spec.c = *end == ',' ? std::strtod(end + 1, &end) : -1;
+        } else if (option == "--exponent" && has_value) {
+            spec.exponent = std::strtod(argv[++i], nullptr);
+        } else if (option == "--max-weight" && has_value) {
+            spec.max_weight = std::strtoul(argv[++i], nullptr, 10);
+        } else if (option == "--threads" && has_value) {
+            set_worker_count(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            return usage();
         }
-
-        // Check if both vertices already exist (have been added to the graph)
-        // Add the origin and target vertices to the set
-        vertices_in_graph.insert(origin);
-        vertices_in_graph.insert(target);
-
-        // Randomly assign a cost to the edge
-        uint32_t cost = std::rand() % 100 + 1;  // Random cost between 1 and 100
-
-        // Write edge to file: origin, target, and cost
-        file << origin << " " << target << " " << cost << std::endl;
     }
 
-    // Close the file
-    file.close();
-
-    // Output info about the generated graph
-    std::cout << "Random graph saved to " << filename << std::endl;
-    std::cout << "Vertices included in the graph: ";
-
-    // Print the vertices that were included in the graph
-    for (const auto& vertex : vertices_in_graph) {
-        std::cout << vertex << " ";
-    }
-    std::cout << std::endl;
-}
-
-int main() {
-    uint32_t n, m;
-    std::string filename;
-    std::cout << "Input name of file: ";
-    std::cin >> filename;
-
-    std::cout << "Input number of vertices and edges\n";
-    std::cin >> n >> m;
-
-    generate_random_graph_to_file(n, m, filename);
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t written;
+    if (!write_generated_graph(spec, filename, binary, written)) return 1;
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::high_resolution_clock::now() - start)
+                         .count();
+    std::cout << "Wrote " << spec.vertices << " vertices and " << written
+              << " edges to " << filename << " in " << seconds << " s ("
+              << (seconds > 0 ? written / seconds : 0) << " edges/s)\n";
+    return 0;
 }